@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * guess.c - simple "guess a number" game
+ *
+ * User inputs a number from 0 to 9, the program generates a random
+ * number in the same range.  main() returns 0 on a win and non-zero
+ * otherwise.
+ *
+ * The --batch N mode runs N rounds inside one process, reading the
+ * guesses in bulk from stdin, so mass simulation runs do not pay
+ * fork+execve+loader+srand startup cost once per round.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GUESS_MIN	0
+#define GUESS_MAX	9
+#define BATCH_BUF_SZ	(1 << 16)
+
+static int generate_number(void)
+{
+	return rand() % (GUESS_MAX - GUESS_MIN + 1) + GUESS_MIN;
+}
+
+static int play_round(void)
+{
+	int guess;
+
+	printf("Enter a number from %d to %d: ", GUESS_MIN, GUESS_MAX);
+	if (scanf("%d", &guess) != 1) {
+		fprintf(stderr, "guess: invalid input\n");
+		return 1;
+	}
+
+	if (guess == generate_number()) {
+		printf("You win\n");
+		return 0;
+	}
+
+	printf("You loose\n");
+	return 1;
+}
+
+/*
+ * Run @rounds rounds in-process.  Guesses are consumed in bulk from
+ * stdin, one digit per byte (whitespace is skipped); once stdin is
+ * exhausted the remaining rounds fall back to random self-play so the
+ * harness can also run unattended.  Prints aggregate wins/losses.
+ */
+static int run_batch(long rounds)
+{
+	static char buf[BATCH_BUF_SZ];
+	long wins = 0, losses = 0, round = 0;
+	size_t len = 0, pos = 0;
+	int eof = 0;
+
+	while (round < rounds) {
+		int guess;
+
+		while (pos == len && !eof) {
+			len = fread(buf, 1, sizeof(buf), stdin);
+			pos = 0;
+			if (len == 0)
+				eof = 1;
+		}
+
+		if (!eof) {
+			char c = buf[pos++];
+
+			if (c < '0' || c > '9')
+				continue;
+			guess = c - '0';
+		} else {
+			guess = generate_number();
+		}
+
+		if (guess == generate_number())
+			wins++;
+		else
+			losses++;
+		round++;
+	}
+
+	printf("rounds=%ld wins=%ld losses=%ld\n", rounds, wins, losses);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	srand(time(NULL) ^ getpid());
+
+	if (argc == 3 && !strcmp(argv[1], "--batch")) {
+		long rounds = strtol(argv[2], NULL, 10);
+
+		if (rounds <= 0) {
+			fprintf(stderr, "guess: bad batch size '%s'\n",
+				argv[2]);
+			return 2;
+		}
+		return run_batch(rounds);
+	}
+
+	if (argc != 1) {
+		fprintf(stderr, "usage: %s [--batch N]\n", argv[0]);
+		return 2;
+	}
+
+	return play_round();
+}
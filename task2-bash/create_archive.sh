@@ -0,0 +1,85 @@
+#!/bin/bash
+# create_archive.sh - package the project into release/guesanumber.tar.gz.
+#
+# Incremental: every file becomes its own gzip member (a tar slice with
+# the end-of-archive padding stripped, compressed separately) cached in
+# release/.cache under its content hash.  A release concatenates the
+# members plus one terminating member -- multi-member gzip decompresses
+# transparently, so gunzip | tar sees one well-formed archive.  Only
+# files whose hash is new are recompressed; an unchanged tree releases
+# from cache in milliseconds, and a one-file change recompresses one
+# member.  The manifest of hashes and sizes lives next to the archive.
+
+set -euo pipefail
+
+PROJECT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+PROJECT_NAME="$(basename "$PROJECT_DIR")"
+RELEASE_DIR="$PROJECT_DIR/release"
+CACHE_DIR="$RELEASE_DIR/.cache"
+ARCHIVE="$RELEASE_DIR/guesanumber.tar.gz"
+MANIFEST="$RELEASE_DIR/manifest.sha256"
+
+# One gzip worker per core when pigz is available.
+if command -v pigz >/dev/null 2>&1; then
+	GZIP_CMD=(pigz -p "$(nproc)")
+else
+	GZIP_CMD=(gzip)
+fi
+
+mkdir -p "$CACHE_DIR"
+
+# Project files, release/ and build products excluded, stable order.
+list_files() {
+	(cd "$PROJECT_DIR/.." && find "$PROJECT_NAME" -type f \
+		! -path "$PROJECT_NAME/release/*" \
+		! -path "$PROJECT_NAME/.git/*" \
+		! -name '*.o' ! -name '*.a' ! -name '*.so' | sort)
+}
+
+# Compress one file into a headerless-tail tar member: tar with a
+# 512-byte blocking factor pads end-of-archive to exactly 1024 zero
+# bytes, which head strips so members can be concatenated.
+make_member() {
+	local path="$1" out="$2"
+	tar -b 1 -C "$PROJECT_DIR/.." \
+		--transform "s|^$PROJECT_NAME|guesanumber|" \
+		-cf - "$path" | head -c -1024 | "${GZIP_CMD[@]}" > "$out"
+}
+
+# Cache key covers path and content: the member embeds the tar header
+# (and so the path), so content alone must not alias renamed or
+# duplicated files onto one member.
+member_key() {
+	printf '%s %s' "$1" "$2" | sha256sum | cut -d' ' -f1
+}
+
+members=()
+: > "$MANIFEST.tmp"
+while IFS= read -r path; do
+	read -r hash _ < <(sha256sum "$PROJECT_DIR/../$path")
+	size=$(stat -c %s "$PROJECT_DIR/../$path")
+	member="$CACHE_DIR/$(member_key "$path" "$hash").tgz"
+	[ -f "$member" ] || make_member "$path" "$member"
+	members+=("$member")
+	printf '%s %s %s\n' "$hash" "$size" "$path" >> "$MANIFEST.tmp"
+done < <(list_files)
+
+# Terminating member: the 1024 zero bytes of tar end-of-archive.
+EOF_MEMBER="$CACHE_DIR/eof.tgz"
+[ -f "$EOF_MEMBER" ] || head -c 1024 /dev/zero | gzip > "$EOF_MEMBER"
+
+cat "${members[@]}" "$EOF_MEMBER" > "$ARCHIVE.tmp"
+mv "$ARCHIVE.tmp" "$ARCHIVE"
+mv "$MANIFEST.tmp" "$MANIFEST"
+
+# Drop cache entries no longer referenced by the manifest.
+live_keys="$(while read -r hash _ path; do
+	member_key "$path" "$hash"
+done < "$MANIFEST")"
+for cached in "$CACHE_DIR"/*.tgz; do
+	key="$(basename "$cached" .tgz)"
+	[ "$key" = "eof" ] && continue
+	grep -qx "$key" <<< "$live_keys" || rm -f "$cached"
+done
+
+echo "Created $ARCHIVE ($(wc -l < "$MANIFEST") files)"
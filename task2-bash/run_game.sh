@@ -0,0 +1,54 @@
+#!/bin/bash
+# run_game.sh - drive the "guess a number" game in a loop.
+#
+# Each iteration asks the user to press "y" to continue, "n" to exit,
+# or a number to run that many tries without asking again.  Numeric
+# runs go through the game's --batch mode so the whole block runs in
+# one process instead of one fork+execve per round.
+
+GAME="${GAME:-$(dirname "$0")/../task1-simple-program/guess}"
+
+GREEN='\033[0;32m'
+RED='\033[0;31m'
+NC='\033[0m'
+
+success=0
+total=0
+
+while true; do
+	read -r -p "Continue? [y/n/number of tries]: " answer
+	case "$answer" in
+	n)
+		break
+		;;
+	y)
+		if "$GAME"; then
+			((success++))
+			echo -e "${GREEN}Good job${NC}"
+		else
+			echo -e "${RED}Wish a good luck next time${NC}"
+		fi
+		((total++))
+		;;
+	''|*[!0-9]*)
+		echo "Please enter y, n or a number"
+		continue
+		;;
+	*)
+		# One process for the whole block: random self-play via
+		# --batch on a closed stdin, parse the aggregate line.
+		stats=$("$GAME" --batch "$answer" </dev/null)
+		wins=$(echo "$stats" | sed 's/.*wins=\([0-9]*\).*/\1/')
+		((success += wins))
+		((total += answer))
+		if ((wins > 0)); then
+			echo -e "${GREEN}Good job${NC}"
+		else
+			echo -e "${RED}Wish a good luck next time${NC}"
+		fi
+		;;
+	esac
+	echo "Successes: $success of $total"
+done
+
+echo "Successes: $success of $total"
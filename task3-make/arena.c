@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * arena.c - fixed-slot arena allocator
+ *
+ * malloc/free per session fragments the heap and contends on the
+ * allocator lock in threaded runs; every session-shaped object here
+ * (simulated players, coroutine stacks) is fixed-size, so a slab of
+ * equal slots with a freelist covers all of them.  Alloc and free are
+ * a pointer swap, reset between tournaments is two stores.  Slabs come
+ * from the bulk buffer layer, so --hugepages puts them on huge pages.
+ */
+
+#include "arena.h"
+#include "hugebuf.h"
+
+int arena_init(struct arena *a, size_t slot_size, size_t capacity)
+{
+	/* a free slot stores the freelist link in-place */
+	if (slot_size < sizeof(void *))
+		slot_size = sizeof(void *);
+	slot_size = (slot_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+	a->slab_len = slot_size * capacity;
+	a->slab = hugebuf_alloc(a->slab_len);
+	if (!a->slab)
+		return -1;
+	a->slot_size = slot_size;
+	a->capacity = capacity;
+	a->used = 0;
+	a->freelist = NULL;
+	return 0;
+}
+
+void *arena_alloc(struct arena *a)
+{
+	void *p = a->freelist;
+
+	if (p) {
+		a->freelist = *(void **)p;
+		return p;
+	}
+	if (a->used == a->capacity)
+		return NULL;
+	return a->slab + a->used++ * a->slot_size;
+}
+
+void arena_free(struct arena *a, void *p)
+{
+	*(void **)p = a->freelist;
+	a->freelist = p;
+}
+
+void arena_reset(struct arena *a)
+{
+	a->used = 0;
+	a->freelist = NULL;
+}
+
+void arena_destroy(struct arena *a)
+{
+	hugebuf_free(a->slab, a->slab_len);
+	a->slab = NULL;
+}
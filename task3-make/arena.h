@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * arena.h - fixed-slot arena allocator
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+ * One slab, fixed-size slots, no locks: give each thread its own
+ * arena.  Allocation is a freelist pop or a bump, free is a freelist
+ * push, and reset reclaims everything at once between tournaments.
+ */
+struct arena {
+	char *slab;
+	size_t slab_len;	/* bytes handed to the buffer layer */
+	size_t slot_size;
+	size_t capacity;	/* slots in the slab */
+	size_t used;		/* bump high-water mark, in slots */
+	void *freelist;
+};
+
+/* Reserve @capacity slots of @slot_size bytes (rounded to pointer size). */
+int arena_init(struct arena *a, size_t slot_size, size_t capacity);
+
+/* O(1); NULL when the arena is exhausted.  Memory is not zeroed. */
+void *arena_alloc(struct arena *a);
+void arena_free(struct arena *a, void *p);
+
+/* Reclaim every slot at once; outstanding pointers become invalid. */
+void arena_reset(struct arena *a);
+void arena_destroy(struct arena *a);
+
+#endif /* ARENA_H */
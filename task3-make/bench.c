@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * bench.c - microbenchmark harness for the game library
+ *
+ * Measures the cost of one self-play round (game_random() +
+ * game_check_guess()) with CLOCK_MONOTONIC_RAW, and with serialized
+ * rdtsc on x86-64, so changes to the generator or comparison logic
+ * are verifiable instead of guessed at.  Runs warmup plus repeated
+ * timed blocks and reports min/median/p99 ns/round and rounds/sec.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "game.h"
+
+#define WARMUP_ROUNDS	1000000
+#define BLOCK_ROUNDS	1000000
+#define REPS		51
+
+#if defined(__x86_64__)
+static inline uint64_t rdtsc_serialized(void)
+{
+	uint32_t lo, hi;
+
+	/* lfence keeps earlier loads from drifting past the read. */
+	__asm__ __volatile__("lfence; rdtsc" : "=a"(lo), "=d"(hi));
+	return (uint64_t)hi << 32 | lo;
+}
+#endif
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Volatile sink so the measured loop cannot be optimized away. */
+static volatile long bench_sink;
+
+static long run_block(long rounds)
+{
+	long wins = 0;
+	long i;
+
+	for (i = 0; i < rounds; i++)
+		wins += game_check_guess(game_random());
+	return wins;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+int main(void)
+{
+	double ns_per_round[REPS];
+#if defined(__x86_64__)
+	double cyc_per_round[REPS];
+#endif
+	double min, med, p99;
+	int r;
+
+	game_seed(0xbe5cbe5cULL);
+	bench_sink = run_block(WARMUP_ROUNDS);
+
+	for (r = 0; r < REPS; r++) {
+		uint64_t t0, t1;
+#if defined(__x86_64__)
+		uint64_t c0, c1;
+
+		c0 = rdtsc_serialized();
+#endif
+		t0 = now_ns();
+		bench_sink = run_block(BLOCK_ROUNDS);
+		t1 = now_ns();
+#if defined(__x86_64__)
+		c1 = rdtsc_serialized();
+		cyc_per_round[r] = (double)(c1 - c0) / BLOCK_ROUNDS;
+#endif
+		ns_per_round[r] = (double)(t1 - t0) / BLOCK_ROUNDS;
+	}
+
+	qsort(ns_per_round, REPS, sizeof(double), cmp_double);
+	min = ns_per_round[0];
+	med = ns_per_round[REPS / 2];
+	p99 = ns_per_round[REPS - 1 - REPS / 100];
+
+	printf("rounds/block: %d, blocks: %d (after %d warmup rounds)\n",
+	       BLOCK_ROUNDS, REPS, WARMUP_ROUNDS);
+	printf("ns/round:   min %.2f  median %.2f  p99 %.2f\n",
+	       min, med, p99);
+	printf("rounds/sec: %.0f (median)\n", 1e9 / med);
+
+#if defined(__x86_64__)
+	qsort(cyc_per_round, REPS, sizeof(double), cmp_double);
+	printf("cycles/round (rdtsc): min %.2f  median %.2f  p99 %.2f\n",
+	       cyc_per_round[0], cyc_per_round[REPS / 2],
+	       cyc_per_round[REPS - 1 - REPS / 100]);
+#endif
+
+	/* Bulk generation path used by the tournament engine. */
+	{
+		static uint8_t fill_buf[BLOCK_ROUNDS];
+		uint64_t t0, t1;
+
+		game_random_fill(fill_buf, sizeof(fill_buf));	/* warmup */
+		t0 = now_ns();
+		for (r = 0; r < 16; r++)
+			game_random_fill(fill_buf, sizeof(fill_buf));
+		t1 = now_ns();
+		bench_sink = fill_buf[0];
+		printf("ns/value (game_random_fill): %.3f\n",
+		       (double)(t1 - t0) / (16.0 * BLOCK_ROUNDS));
+	}
+	return 0;
+}
@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * compare.h - batch guess/target comparison kernel
+ */
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Count positions where guesses[i] == targets[i].  Dispatches at
+ * first call to the widest kernel the CPU supports (AVX2, SSE2 or
+ * scalar).
+ */
+long guess_count_matches(const uint8_t *guesses, const uint8_t *targets,
+			 size_t n);
+
+#endif /* COMPARE_H */
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * coro.c - stackful coroutine scheduler
+ *
+ * One OS thread per simulated player collapses around 10k players
+ * from stack and scheduler overhead; a coroutine needs only a small
+ * fixed stack and a userspace context switch.  Stacks are fixed-size
+ * slots from the scheduler's arena, so 100k players cost a few
+ * hundred MB, spawning is a pointer bump, and a finished coroutine's
+ * stack is reusable immediately.  Each scheduler is single threaded;
+ * run one per core for parallel simulations.
+ */
+
+#include <stdint.h>
+
+#include "coro.h"
+
+#define CORO_STACK_SZ	(16 * 1024)
+
+static void ready_push(struct coro_sched *s, struct coro *coro)
+{
+	coro->next = NULL;
+	if (s->ready_tail)
+		s->ready_tail->next = coro;
+	else
+		s->ready_head = coro;
+	s->ready_tail = coro;
+}
+
+static struct coro *ready_pop(struct coro_sched *s)
+{
+	struct coro *coro = s->ready_head;
+
+	if (coro) {
+		s->ready_head = coro->next;
+		if (!s->ready_head)
+			s->ready_tail = NULL;
+	}
+	return coro;
+}
+
+int coro_sched_init(struct coro_sched *s, long max_coros)
+{
+	if (arena_init(&s->stacks, CORO_STACK_SZ, max_coros))
+		return -1;
+	s->ready_head = NULL;
+	s->ready_tail = NULL;
+	s->active = 0;
+	return 0;
+}
+
+void coro_sched_destroy(struct coro_sched *s)
+{
+	arena_destroy(&s->stacks);
+}
+
+/* makecontext() only passes ints portably, so the pointer rides split. */
+static void coro_trampoline(unsigned int hi, unsigned int lo)
+{
+	struct coro *coro = (struct coro *)(((uintptr_t)hi << 32) | lo);
+
+	coro->fn(coro, coro->arg);
+	coro->done = 1;
+	/* uc_link returns to the scheduler */
+}
+
+int coro_spawn(struct coro_sched *s, struct coro *coro,
+	       void (*fn)(struct coro *coro, void *arg), void *arg)
+{
+	uintptr_t p = (uintptr_t)coro;
+	void *stack = arena_alloc(&s->stacks);
+
+	if (!stack)
+		return -1;
+
+	coro->sched = s;
+	coro->fn = fn;
+	coro->arg = arg;
+	coro->done = 0;
+
+	if (getcontext(&coro->ctx)) {
+		arena_free(&s->stacks, stack);
+		return -1;
+	}
+	coro->ctx.uc_stack.ss_sp = stack;
+	coro->ctx.uc_stack.ss_size = CORO_STACK_SZ;
+	coro->ctx.uc_link = &s->main_ctx;
+
+	makecontext(&coro->ctx, (void (*)(void))coro_trampoline, 2,
+		    (unsigned int)(p >> 32), (unsigned int)p);
+	ready_push(s, coro);
+	s->active++;
+	return 0;
+}
+
+void coro_yield(struct coro *coro)
+{
+	struct coro_sched *s = coro->sched;
+
+	ready_push(s, coro);
+	swapcontext(&coro->ctx, &s->main_ctx);
+}
+
+void coro_sched_run(struct coro_sched *s)
+{
+	while (s->active) {
+		struct coro *coro = ready_pop(s);
+
+		if (!coro)
+			break;
+		swapcontext(&s->main_ctx, &coro->ctx);
+		if (coro->done) {
+			/* the stack is dead: uc_link already ran us */
+			arena_free(&s->stacks, coro->ctx.uc_stack.ss_sp);
+			s->active--;
+		}
+	}
+}
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * coro.h - stackful coroutine scheduler (one scheduler per thread)
+ */
+#ifndef CORO_H
+#define CORO_H
+
+#include <stddef.h>
+#include <ucontext.h>
+
+#include "arena.h"
+
+struct coro_sched;
+
+struct coro {
+	ucontext_t ctx;
+	struct coro *next;	/* ready-queue link */
+	struct coro_sched *sched;
+	void (*fn)(struct coro *coro, void *arg);
+	void *arg;
+	int done;
+};
+
+struct coro_sched {
+	ucontext_t main_ctx;
+	struct coro *ready_head;
+	struct coro *ready_tail;
+	/* fixed-size coroutine stacks */
+	struct arena stacks;
+	long active;
+};
+
+/* Reserve stack arena for up to @max_coros coroutines. */
+int coro_sched_init(struct coro_sched *s, long max_coros);
+void coro_sched_destroy(struct coro_sched *s);
+
+/* Create a runnable coroutine; fails (-1) when the arena is full. */
+int coro_spawn(struct coro_sched *s, struct coro *coro,
+	       void (*fn)(struct coro *coro, void *arg), void *arg);
+
+/* Give up the CPU; the coroutine is rescheduled after the ready queue. */
+void coro_yield(struct coro *coro);
+
+/* Run until every spawned coroutine has finished. */
+void coro_sched_run(struct coro_sched *s);
+
+#endif /* CORO_H */
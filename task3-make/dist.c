@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * dist.c - distributed tournament: worker streaming and aggregation
+ *
+ * Statistical runs larger than one machine used to mean per-host text
+ * logs copied around and merged by a script after the fact.  Here the
+ * merge is part of the run: each worker node executes the normal
+ * multi-threaded tournament locally in chunks and streams one
+ * fixed-size binary delta per chunk over TCP; the aggregator (the same
+ * binary) folds deltas into the running totals and the 10x10 joint
+ * table as they arrive.  When the last worker disconnects the merged
+ * result is already complete -- there is no post-processing pass.
+ * Chunk wall times feed the standard latency histogram, so straggler
+ * nodes show up in the percentile tail.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dist.h"
+#include "hist.h"
+#include "tournament.h"
+
+/* big enough to amortize thread start-up, small enough to stream */
+#define DIST_CHUNK	(1L << 22)
+#define DIST_MAX_NODES	64
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int write_all(int fd, const void *buf, size_t len)
+{
+	const char *p = buf;
+
+	while (len) {
+		ssize_t n = write(fd, p, len);
+
+		if (n <= 0)
+			return -1;
+		p += n;
+		len -= n;
+	}
+	return 0;
+}
+
+static int dist_connect(const char *hostport)
+{
+	char host[256];
+	struct addrinfo hints = { .ai_socktype = SOCK_STREAM };
+	struct addrinfo *res, *ai;
+	const char *colon = strrchr(hostport, ':');
+	int fd = -1;
+
+	if (!colon || colon == hostport ||
+	    (size_t)(colon - hostport) >= sizeof(host))
+		return -1;
+	memcpy(host, hostport, colon - hostport);
+	host[colon - hostport] = '\0';
+
+	if (getaddrinfo(host, colon + 1, &hints, &res))
+		return -1;
+
+	for (ai = res; ai; ai = ai->ai_next) {
+		fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (fd < 0)
+			continue;
+		if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+			break;
+		close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+	return fd;
+}
+
+int dist_worker_run(const char *hostport, long rounds, int nthreads,
+		    uint64_t seed)
+{
+	struct dist_delta delta;
+	long left = rounds;
+	uint64_t idx = 0;
+	int fd, one = 1;
+
+	fd = dist_connect(hostport);
+	if (fd < 0) {
+		fprintf(stderr, "guess: cannot reach aggregator %s\n",
+			hostport);
+		return -1;
+	}
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+	while (left > 0) {
+		long n = left < DIST_CHUNK ? left : DIST_CHUNK;
+		/* per-chunk seeds, same derivation as recorded runs */
+		uint64_t cseed = seed ? seed + idx * 0x9e3779b97f4a7c15ULL : 0;
+		static struct stats_table table;
+		struct tournament_result res;
+		uint64_t t0 = now_ns();
+
+		memset(&table, 0, sizeof(table));
+		if (tournament_run(n, nthreads, cseed, &res, &table, 0)) {
+			close(fd);
+			return -1;
+		}
+
+		delta.magic = DIST_MAGIC;
+		delta.node = (uint32_t)getpid();
+		delta.chunk_ns = now_ns() - t0;
+		delta.rounds = res.rounds;
+		delta.wins = res.wins;
+		memcpy(delta.counts, table.counts, sizeof(delta.counts));
+
+		if (write_all(fd, &delta, sizeof(delta)) < 0) {
+			fprintf(stderr, "guess: aggregator went away\n");
+			close(fd);
+			return -1;
+		}
+		left -= n;
+		idx++;
+	}
+
+	close(fd);
+	return 0;
+}
+
+struct dist_conn {
+	int fd;
+	size_t off;
+	struct dist_delta delta;
+};
+
+/* Consume whatever is readable; returns -1 once the worker is done. */
+static int conn_drain(struct dist_conn *c, uint64_t *rounds, uint64_t *wins,
+		      struct stats_table *stats, struct latency_hist *chunks)
+{
+	for (;;) {
+		ssize_t n = read(c->fd, (char *)&c->delta + c->off,
+				 sizeof(c->delta) - c->off);
+
+		if (n == 0)
+			return -1;
+		if (n < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return 0;	/* wait for more */
+			if (errno == EINTR)
+				continue;
+			return -1;	/* worker died mid-run */
+		}
+		c->off += n;
+		if (c->off < sizeof(c->delta))
+			continue;
+		c->off = 0;
+
+		if (c->delta.magic != DIST_MAGIC) {
+			fprintf(stderr, "guess: bad delta, dropping node\n");
+			return -1;
+		}
+		*rounds += c->delta.rounds;
+		*wins += c->delta.wins;
+		hist_record(chunks, c->delta.chunk_ns);
+		if (stats)
+			stats_merge(stats,
+				    (const struct stats_table *)c->delta.counts);
+	}
+}
+
+int dist_aggregate_run(int port, int nnodes, struct stats_table *stats)
+{
+	struct dist_conn conns[DIST_MAX_NODES];
+	struct latency_hist chunks;
+	struct epoll_event ev, evs[16];
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_addr.s_addr = htonl(INADDR_ANY),
+		.sin_port = htons(port),
+	};
+	uint64_t rounds = 0, wins = 0;
+	int lfd, efd, one = 1, joined = 0, active = 0;
+
+	if (nnodes < 1 || nnodes > DIST_MAX_NODES) {
+		fprintf(stderr, "guess: node count must be 1..%d\n",
+			DIST_MAX_NODES);
+		return -1;
+	}
+	memset(&chunks, 0, sizeof(chunks));
+
+	lfd = socket(AF_INET, SOCK_STREAM, 0);
+	if (lfd < 0)
+		return -1;
+	setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	if (bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(lfd, nnodes) < 0) {
+		perror("guess: aggregator bind");
+		close(lfd);
+		return -1;
+	}
+
+	efd = epoll_create1(0);
+	if (efd < 0) {
+		close(lfd);
+		return -1;
+	}
+	ev.events = EPOLLIN;
+	ev.data.ptr = NULL;	/* NULL marks the listener */
+	epoll_ctl(efd, EPOLL_CTL_ADD, lfd, &ev);
+
+	fprintf(stderr, "guess: aggregating %d node(s) on port %d\n",
+		nnodes, port);
+
+	/* run until every expected worker has joined and finished */
+	while (joined < nnodes || active > 0) {
+		int n = epoll_wait(efd, evs, 16, -1);
+		int i;
+
+		if (n < 0)
+			continue;
+
+		for (i = 0; i < n; i++) {
+			struct dist_conn *c = evs[i].data.ptr;
+
+			if (!c) {
+				int cfd = accept4(lfd, NULL, NULL,
+						  SOCK_NONBLOCK);
+
+				if (cfd < 0 || joined >= nnodes) {
+					if (cfd >= 0)
+						close(cfd);
+					continue;
+				}
+				c = &conns[joined++];
+				c->fd = cfd;
+				c->off = 0;
+				active++;
+				ev.events = EPOLLIN;
+				ev.data.ptr = c;
+				epoll_ctl(efd, EPOLL_CTL_ADD, cfd, &ev);
+				continue;
+			}
+
+			/*
+			 * Drain first even on error/hangup events: a
+			 * worker's final deltas may still be queued
+			 * ahead of its FIN or reset.
+			 */
+			if (conn_drain(c, &rounds, &wins, stats,
+				       &chunks) < 0 ||
+			    (evs[i].events & (EPOLLHUP | EPOLLERR))) {
+				epoll_ctl(efd, EPOLL_CTL_DEL, c->fd, NULL);
+				close(c->fd);
+				active--;
+			}
+		}
+	}
+
+	close(efd);
+	close(lfd);
+
+	printf("rounds=%llu wins=%llu losses=%llu\n",
+	       (unsigned long long)rounds, (unsigned long long)wins,
+	       (unsigned long long)(rounds - wins));
+	if (chunks.total)
+		hist_dump(&chunks, stderr, "worker chunk wall time");
+	return 0;
+}
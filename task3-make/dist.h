@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * dist.h - distributed tournament: worker streaming and aggregation
+ */
+#ifndef DIST_H
+#define DIST_H
+
+#include <stdint.h>
+
+#include "stats.h"
+
+#define DIST_MAGIC	0x67744431	/* "gtD1" */
+
+/*
+ * One fixed-size counter delta, the only thing that crosses the wire.
+ * Each delta carries the counts of one locally completed chunk (not
+ * running totals), so the aggregator merges by plain addition and a
+ * worker needs no state about what it already sent.  Fields are host
+ * byte order: the pools this runs on are homogeneous x86.
+ */
+struct dist_delta {
+	uint32_t magic;
+	uint32_t node;
+	uint64_t chunk_ns;	/* wall time of this chunk */
+	uint64_t rounds;
+	uint64_t wins;
+	uint64_t counts[GUESS_RANGE][GUESS_RANGE];
+};
+
+/*
+ * Worker side: run @rounds tournament rounds locally in chunks and
+ * stream one delta per chunk to the aggregator at @hostport
+ * ("HOST:PORT").  @nthreads and @seed behave as in tournament_run().
+ */
+int dist_worker_run(const char *hostport, long rounds, int nthreads,
+		    uint64_t seed);
+
+/*
+ * Aggregator side: accept @nnodes workers on @port, merge their deltas
+ * as they arrive and report the moment the last worker disconnects.
+ * A non-NULL @stats additionally accumulates the joint distribution.
+ */
+int dist_aggregate_run(int port, int nnodes, struct stats_table *stats);
+
+#endif /* DIST_H */
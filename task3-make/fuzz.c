@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * fuzz.c - AFL-compatible persistent-mode harness for the guess parser
+ *
+ * Fuzzing the parse path through execve costs a process per test
+ * case.  Built with afl-clang-fast/afl-gcc-fast this harness runs as
+ * a deferred fork server with persistent mode: initialize once, then
+ * loop test cases in-process; under a plain compiler it degrades to
+ * one case from stdin, so it also serves as a reproducer runner.
+ * Per-case session state comes from an arena reset between
+ * iterations, so no state (or heap growth) leaks across cases.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "game.h"
+
+#define CASE_MAX	4096
+
+struct fuzz_session {
+	int guess;
+	int won;
+	char line[CASE_MAX + 1];
+};
+
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+#define FUZZ_LOOP()	__AFL_LOOP(100000)
+#else
+static int fuzz_once = 1;
+#define FUZZ_LOOP()	(fuzz_once--)
+#endif
+
+int main(void)
+{
+	struct arena sessions;
+
+	/* one-time setup before the fork-server split */
+	arena_init(&sessions, sizeof(struct fuzz_session), 16);
+	game_seed(0xf022);
+
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+	__AFL_INIT();
+#endif
+
+	while (FUZZ_LOOP()) {
+		struct fuzz_session *s = arena_alloc(&sessions);
+		ssize_t n;
+
+		if (!s)
+			break;
+		n = read(STDIN_FILENO, s->line, CASE_MAX);
+		if (n < 0)
+			n = 0;
+		s->line[n] = '\0';
+
+		if (game_parse_guess(s->line, &s->guess) == 0)
+			s->won = game_check_guess(s->guess);
+
+		/* bulk reset: nothing survives into the next case */
+		arena_reset(&sessions);
+	}
+
+	arena_destroy(&sessions);
+	return 0;
+}
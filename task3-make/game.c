@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * game.c - "guess a number" game library
+ *
+ * Holds all non-main() code of task1, as required by task3: the game
+ * round logic and the random-number generator.
+ *
+ * The generator is xoshiro256**: a few shifts and rotates per output,
+ * no locks, and an explicit seed API.  State is per-thread, so batch
+ * and parallel modes get fast, independent streams instead of the
+ * shared (and in some libcs lock-protected) rand() state seeded from
+ * time(NULL) once per process.
+ */
+
+#include <stdio.h>
+#include <sys/random.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "probes.h"
+
+struct xoshiro256_state {
+	uint64_t s[4];
+	int seeded;
+};
+
+static __thread struct xoshiro256_state prng;
+
+static inline uint64_t rotl64(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64: expands one 64-bit seed into the full generator state. */
+static uint64_t splitmix64_next(uint64_t *x)
+{
+	uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+void game_seed(uint64_t seed)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+		prng.s[i] = splitmix64_next(&seed);
+	prng.seeded = 1;
+}
+
+/*
+ * Distinct per-thread fallback seed for threads that never call
+ * game_seed().  Entropy comes from one getrandom(GRND_NONBLOCK) call
+ * per process, cached so further threads (and the common single-shot
+ * run) pay no extra syscall; if the pool is not ready yet the old
+ * clock/pid mix fills in.  Either way the per-thread TLS address is
+ * folded in, so no two threads share a stream.
+ */
+static void game_autoseed(void)
+{
+	static uint64_t entropy_cache;
+	uint64_t base;
+
+	base = __atomic_load_n(&entropy_cache, __ATOMIC_RELAXED);
+	if (!base) {
+		if (getrandom(&base, sizeof(base), GRND_NONBLOCK) !=
+		    sizeof(base) || !base) {
+			struct timespec ts;
+
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			base = (uint64_t)ts.tv_sec << 32 ^ ts.tv_nsec ^
+			       (uint64_t)getpid() << 16;
+		}
+		__atomic_store_n(&entropy_cache, base, __ATOMIC_RELAXED);
+	}
+
+	game_seed(base ^ (uintptr_t)&prng);
+}
+
+uint64_t game_random64(void)
+{
+	uint64_t *s = prng.s;
+	uint64_t result, t;
+
+	if (!prng.seeded)
+		game_autoseed();
+
+	GUESS_PROBE(rng);
+	result = rotl64(s[1] * 5, 7) * 9;
+	t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl64(s[3], 45);
+
+	return result;
+}
+
+int game_random(void)
+{
+#if !(GUESS_RANGE & (GUESS_RANGE - 1))
+	/* power-of-two range: a mask instead of the modulo */
+	return (int)(game_random64() & (GUESS_RANGE - 1)) + GUESS_MIN;
+#else
+	return (int)(game_random64() % GUESS_RANGE) + GUESS_MIN;
+#endif
+}
+
+/*
+ * Bulk generation: one generator step yields eight digit bytes, each
+ * mapped to [GUESS_MIN, GUESS_MAX] with a multiply-shift instead of a
+ * division.  For power-of-two ranges the map is exact; otherwise the
+ * byte->value map carries a small per-value bias (<0.4% at range 10,
+ * 26/256 vs 25/256 for the low values), far below the sampling noise
+ * of the Monte-Carlo runs this feeds; single-value game_random()
+ * keeps the unbiased-in-practice 64-bit modulo.
+ */
+void game_random_fill(uint8_t *buf, size_t n)
+{
+	size_t i = 0;
+
+	if (!prng.seeded)
+		game_autoseed();
+
+	for (; i + 8 <= n; i += 8) {
+		uint64_t r = game_random64();
+		int b;
+
+		for (b = 0; b < 8; b++) {
+			buf[i + b] = (uint8_t)((((r & 0xff) * GUESS_RANGE)
+						>> 8) + GUESS_MIN);
+			r >>= 8;
+		}
+	}
+
+	if (i < n) {
+		uint64_t r = game_random64();
+
+		for (; i < n; i++) {
+			buf[i] = (uint8_t)((((r & 0xff) * GUESS_RANGE)
+					    >> 8) + GUESS_MIN);
+			r >>= 8;
+		}
+	}
+}
+
+int game_check_guess(int guess)
+{
+	int won;
+
+	GUESS_PROBE1(round_start, guess);
+	won = guess == game_random();
+	GUESS_PROBE2(result, guess, won);
+	return won;
+}
+
+int game_parse_guess(const char *line, int *guess)
+{
+	int val;
+
+	if (sscanf(line, "%d", &val) != 1)
+		return -1;
+	if (val < GUESS_MIN || val > GUESS_MAX)
+		return -1;
+	*guess = val;
+	return 0;
+}
+
+int game_play_round(void)
+{
+	char line[64];
+	int guess;
+
+	printf("Enter a number from %d to %d: ", GUESS_MIN, GUESS_MAX);
+	if (!fgets(line, sizeof(line), stdin) ||
+	    game_parse_guess(line, &guess)) {
+		fprintf(stderr, "guess: invalid input\n");
+		return 1;
+	}
+
+	if (game_check_guess(guess)) {
+		printf("You win\n");
+		return 0;
+	}
+
+	printf("You loose\n");
+	return 1;
+}
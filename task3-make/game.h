@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * game.h - "guess a number" game library interface
+ */
+#ifndef GAME_H
+#define GAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The guess range is a compile-time constant (Makefile RANGE= option
+ * overrides GUESS_MAX), so every modulo and bounds check against it is
+ * folded by the compiler; power-of-two ranges reduce to mask
+ * arithmetic.  Guesses travel as single bytes through the batch
+ * buffers, the ring transport and the wire deltas, and byte 0xff is
+ * the transport shutdown sentinel, which caps the range at 255.
+ */
+#define GUESS_MIN	0
+#ifndef GUESS_MAX
+#define GUESS_MAX	9
+#endif
+#define GUESS_RANGE	(GUESS_MAX - GUESS_MIN + 1)
+
+#if GUESS_RANGE < 2 || GUESS_RANGE > 255
+#error "GUESS_RANGE must be within 2..255"
+#endif
+
+/*
+ * Explicitly seed the calling thread's PRNG stream.  Threads that
+ * never call this get an independent stream seeded on first use.
+ */
+void game_seed(uint64_t seed);
+
+/* Next raw 64-bit PRNG output for the calling thread. */
+uint64_t game_random64(void);
+
+/* Random number in [GUESS_MIN, GUESS_MAX]. */
+int game_random(void);
+
+/*
+ * Fill @buf with @n random values in [GUESS_MIN, GUESS_MAX], eight
+ * digits per generator step, for batch consumers that would otherwise
+ * pay a call per value.
+ */
+void game_random_fill(uint8_t *buf, size_t n);
+
+/*
+ * Parse one guess line; returns 0 and sets *guess on a valid in-range
+ * number, -1 otherwise.  This is the input validation every
+ * interactive front end (and the fuzz harness) goes through.
+ */
+int game_parse_guess(const char *line, int *guess);
+
+/* One interactive round; returns 0 on win, non-zero otherwise. */
+int game_play_round(void);
+
+/* One non-interactive round with a given guess; returns 1 on win. */
+int game_check_guess(int guess);
+
+#endif /* GAME_H */
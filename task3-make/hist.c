@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * hist.c - log-bucketed (HDR-style) latency histogram
+ *
+ * Average rounds/sec hides the tail; the server mode cares about
+ * p99.9 per-guess latency.  Recording lives in the header as a
+ * two-op inline; here is only the cold dump path, which walks the
+ * fixed bucket array and reports percentiles at bucket-midpoint
+ * resolution.
+ */
+
+#include <string.h>
+
+#include "hist.h"
+
+/* Midpoint of the value range a slot covers. */
+static uint64_t slot_mid(unsigned int idx)
+{
+	unsigned int shift = idx >> 4;
+	uint64_t lo;
+
+	if (idx < 16)
+		return idx;
+	lo = (uint64_t)((idx & 0xf) | 0x8) << shift;
+	/* slot width is 2^shift */
+	return lo + ((uint64_t)1 << shift) / 2;
+}
+
+static uint64_t hist_percentile(const struct latency_hist *h, double pct)
+{
+	uint64_t rank = (uint64_t)(pct / 100.0 * (double)h->total);
+	uint64_t seen = 0;
+	unsigned int i;
+
+	if (rank >= h->total)
+		return h->max;
+	for (i = 0; i < HIST_SLOTS; i++) {
+		uint64_t mid;
+
+		seen += h->counts[i];
+		if (seen <= rank)
+			continue;
+		/* a midpoint can overshoot the largest recorded sample */
+		mid = slot_mid(i);
+		return mid < h->max ? mid : h->max;
+	}
+	return h->max;
+}
+
+void hist_dump(const struct latency_hist *h, FILE *f, const char *name)
+{
+	static const double pcts[] = { 50, 90, 99, 99.9, 99.99 };
+	unsigned int i;
+
+	if (!h->total) {
+		fprintf(f, "%s: no samples\n", name);
+		return;
+	}
+
+	fprintf(f, "%s: %llu samples\n", name,
+		(unsigned long long)h->total);
+	for (i = 0; i < sizeof(pcts) / sizeof(pcts[0]); i++)
+		fprintf(f, "  p%-6g %llu ns\n", pcts[i],
+			(unsigned long long)hist_percentile(h, pcts[i]));
+	fprintf(f, "  max    %llu ns\n", (unsigned long long)h->max);
+}
+
+void hist_reset(struct latency_hist *h)
+{
+	memset(h, 0, sizeof(*h));
+}
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * hist.h - log-bucketed (HDR-style) latency histogram
+ */
+#ifndef HIST_H
+#define HIST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Log-linear buckets: exact below 16, then 16 sub-buckets (top four
+ * bits) per power of two.  1024 fixed slots cover the full 64-bit ns
+ * range in 8 KB, so recording is two arithmetic ops and one increment
+ * with no allocation on the hot path.
+ */
+#define HIST_SLOTS	1024
+
+struct latency_hist {
+	uint64_t counts[HIST_SLOTS];
+	uint64_t total;
+	uint64_t max;
+};
+
+static inline unsigned int hist_index(uint64_t v)
+{
+	unsigned int shift;
+
+	if (v < 16)
+		return (unsigned int)v;
+	shift = (63 - __builtin_clzll(v)) - 3;
+	return (shift << 4) | ((v >> shift) & 0xf);
+}
+
+static inline void hist_record(struct latency_hist *h, uint64_t ns)
+{
+	h->counts[hist_index(ns)]++;
+	h->total++;
+	if (ns > h->max)
+		h->max = ns;
+}
+
+/* Print a percentile table (p50..p99.99 and max) to @f. */
+void hist_dump(const struct latency_hist *h, FILE *f, const char *name);
+
+void hist_reset(struct latency_hist *h);
+
+#endif /* HIST_H */
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * hugebuf.c - huge-page-backed bulk buffer allocation
+ *
+ * The big simulation runs keep hundreds of megabytes of player state
+ * and coroutine stacks live, and with 4 KiB pages the walk over them
+ * is dTLB-miss bound.  This layer is where all such slabs come from:
+ * by default a plain anonymous mmap, with --hugepages an explicit
+ * 2 MiB hugetlb mapping when the pool has pages, else the same plain
+ * mapping with MADV_HUGEPAGE so khugepaged can back it transparently.
+ * The fallback chain is decided once at first allocation and reported
+ * to stderr, so a run that silently missed its hugetlb reservation is
+ * visible; the dTLB and page-fault counters in the self-profiler show
+ * whether the backing paid off.
+ */
+
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "hugebuf.h"
+
+#define HUGE_SZ		(2UL << 20)
+
+enum {
+	HUGEBUF_PLAIN,		/* huge pages not requested */
+	HUGEBUF_HUGETLB,	/* explicit 2 MiB pages */
+	HUGEBUF_THP,		/* madvise'd, khugepaged decides */
+	HUGEBUF_UNDECIDED,
+};
+
+static int hugebuf_wanted;
+static int hugebuf_mode = HUGEBUF_PLAIN;
+
+void hugebuf_enable(int on)
+{
+	hugebuf_wanted = on;
+	hugebuf_mode = on ? HUGEBUF_UNDECIDED : HUGEBUF_PLAIN;
+}
+
+static size_t hugebuf_len(size_t len)
+{
+	if (hugebuf_wanted)
+		len = (len + HUGE_SZ - 1) & ~(HUGE_SZ - 1);
+	return len;
+}
+
+void *hugebuf_alloc(size_t len)
+{
+	void *p;
+
+	len = hugebuf_len(len);
+
+	if (hugebuf_wanted) {
+		p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (p != MAP_FAILED) {
+			if (hugebuf_mode == HUGEBUF_UNDECIDED) {
+				hugebuf_mode = HUGEBUF_HUGETLB;
+				fprintf(stderr,
+					"guess: buffers on hugetlb pages\n");
+			}
+			return p;
+		}
+	}
+
+	p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+		 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		return NULL;
+
+	if (hugebuf_wanted) {
+		madvise(p, len, MADV_HUGEPAGE);
+		if (hugebuf_mode == HUGEBUF_UNDECIDED) {
+			hugebuf_mode = HUGEBUF_THP;
+			fprintf(stderr,
+				"guess: no hugetlb pages, using THP madvise\n");
+		}
+	}
+	return p;
+}
+
+void hugebuf_free(void *p, size_t len)
+{
+	if (p)
+		munmap(p, hugebuf_len(len));
+}
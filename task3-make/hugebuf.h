@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * hugebuf.h - huge-page-backed bulk buffer allocation
+ */
+#ifndef HUGEBUF_H
+#define HUGEBUF_H
+
+#include <stddef.h>
+
+/*
+ * Opt the process into huge-page backing (--hugepages).  Takes effect
+ * for allocations made after the call; must not change while buffers
+ * from this layer are live, since free recomputes the mapped length
+ * from the mode.
+ */
+void hugebuf_enable(int on);
+
+/*
+ * Allocate/free one bulk buffer.  With huge pages enabled the
+ * allocation is tried as explicit hugetlb first, then as a normal
+ * mapping with transparent-huge-page madvise, then plain -- callers
+ * never see the difference.  @len to free must match the allocation.
+ */
+void *hugebuf_alloc(size_t len);
+void hugebuf_free(void *p, size_t len);
+
+#endif /* HUGEBUF_H */
@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * input.h - bulk-buffered guess input layer
+ */
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stddef.h>
+
+struct guess_input {
+	const char *buf;	/* current window of guess bytes */
+	size_t len;		/* valid bytes in buf */
+	size_t pos;		/* consume position */
+	size_t map_len;		/* non-zero when buf is a whole-file mmap */
+	char *rdbuf;		/* block-read buffer when streaming */
+	int fd;
+	int eof;
+	int tty;
+	int num;		/* decimal accumulator (ranges above 10) */
+	int ndigits;		/* digits accumulated so far */
+};
+
+/*
+ * Attach to @fd.  Regular files are mmap'd whole; pipes and other
+ * streams are consumed through a large block-read buffer; a TTY gets
+ * interactive prompting from guess_input_next().
+ */
+int guess_input_init(struct guess_input *in, int fd);
+
+/*
+ * Next guess, or -1 on end of input / read error.  For ranges up to 10
+ * every digit byte is one guess; larger ranges read whitespace- (or
+ * any non-digit-) separated decimal numbers, out-of-range ones
+ * skipped.
+ */
+int guess_input_next(struct guess_input *in);
+
+void guess_input_destroy(struct guess_input *in);
+
+#endif /* INPUT_H */
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * ipc.c - SPSC shared-memory ring transport between harness and game
+ *
+ * When the interactive harness has to stay a separate process, a pipe
+ * pair costs about four syscalls per round.  This transport replaces
+ * the pipes with two byte rings in one POSIX shm segment: guesses flow
+ * one way, results the other.  Each ring has exactly one producer and
+ * one consumer, so an acquire load of the far cursor and a release
+ * store of the own one are the whole protocol; futexes are entered
+ * only after a bounded spin finds the ring still empty (or full), and
+ * a wake is issued only on the empty->non-empty (full->non-full)
+ * transition, keeping the common case syscall-free.
+ */
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "ipc.h"
+
+#define IPC_SHM_MAGIC	0x67737231	/* "gsr1" */
+#define IPC_SPIN	4096
+
+static long futex(_Atomic uint32_t *addr, int op, uint32_t val)
+{
+	return syscall(SYS_futex, addr, op, val, NULL, NULL, 0);
+}
+
+void ipc_ring_push(struct ipc_ring *r, uint8_t v)
+{
+	uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+	uint32_t head;
+	int spin = IPC_SPIN;
+
+	while ((head = atomic_load_explicit(&r->head,
+					    memory_order_acquire)) ==
+	       tail - IPC_RING_SZ) {
+		if (--spin > 0)
+			continue;
+		futex(&r->head, FUTEX_WAIT, head);
+		spin = IPC_SPIN;
+	}
+
+	r->buf[tail & (IPC_RING_SZ - 1)] = v;
+	atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+
+	/* consumer may be parked only if it saw the ring empty */
+	if (head == tail)
+		futex(&r->tail, FUTEX_WAKE, 1);
+}
+
+uint8_t ipc_ring_pop(struct ipc_ring *r)
+{
+	uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+	uint32_t tail;
+	uint8_t v;
+	int spin = IPC_SPIN;
+
+	while ((tail = atomic_load_explicit(&r->tail,
+					    memory_order_acquire)) == head) {
+		if (--spin > 0)
+			continue;
+		futex(&r->tail, FUTEX_WAIT, head);
+		spin = IPC_SPIN;
+	}
+
+	v = r->buf[head & (IPC_RING_SZ - 1)];
+	atomic_store_explicit(&r->head, head + 1, memory_order_release);
+
+	/* producer may be parked only if it saw the ring full */
+	if (tail - head == IPC_RING_SZ)
+		futex(&r->head, FUTEX_WAKE, 1);
+	return v;
+}
+
+struct ipc_shm *ipc_shm_map(const char *name, int create)
+{
+	struct ipc_shm *shm;
+	int flags = create ? O_CREAT | O_RDWR : O_RDWR;
+	int fd;
+
+	fd = shm_open(name, flags, 0600);
+	if (fd < 0)
+		return NULL;
+	if (create && ftruncate(fd, sizeof(*shm)) < 0) {
+		close(fd);
+		shm_unlink(name);
+		return NULL;
+	}
+	if (!create) {
+		struct stat st;
+
+		/*
+		 * Attaching can race the creator between its shm_open
+		 * and ftruncate; mapping a still-empty segment would
+		 * SIGBUS on first touch instead of failing the attach
+		 * (and letting the caller's retry loop try again).
+		 */
+		if (fstat(fd, &st) < 0 ||
+		    st.st_size < (off_t)sizeof(*shm)) {
+			close(fd);
+			return NULL;
+		}
+	}
+
+	shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED,
+		   fd, 0);
+	close(fd);
+	if (shm == MAP_FAILED)
+		return NULL;
+
+	if (create) {
+		memset(shm, 0, sizeof(*shm));
+		atomic_store_explicit((_Atomic uint32_t *)&shm->magic,
+				      IPC_SHM_MAGIC, memory_order_release);
+	} else if (shm->magic != IPC_SHM_MAGIC) {
+		munmap(shm, sizeof(*shm));
+		return NULL;
+	}
+	return shm;
+}
+
+void ipc_shm_unmap(struct ipc_shm *shm, const char *name, int created)
+{
+	munmap(shm, sizeof(*shm));
+	if (created)
+		shm_unlink(name);
+}
+
+int ipc_serve(const char *name)
+{
+	struct ipc_shm *shm;
+	long rounds = 0, wins = 0;
+
+	shm = ipc_shm_map(name, 1);
+	if (!shm) {
+		perror(name);
+		return -1;
+	}
+
+	for (;;) {
+		uint8_t guess = ipc_ring_pop(&shm->guess);
+
+		if (guess == IPC_SHUTDOWN)
+			break;
+		if (game_check_guess(guess)) {
+			ipc_ring_push(&shm->result, 1);
+			wins++;
+		} else {
+			ipc_ring_push(&shm->result, 0);
+		}
+		rounds++;
+	}
+
+	printf("rounds=%ld wins=%ld losses=%ld\n", rounds, wins,
+	       rounds - wins);
+	ipc_shm_unmap(shm, name, 1);
+	return 0;
+}
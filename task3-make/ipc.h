@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * ipc.h - SPSC shared-memory ring transport between harness and game
+ */
+#ifndef IPC_H
+#define IPC_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define IPC_RING_SZ	4096	/* bytes, power of two */
+
+/*
+ * Sentinel guess telling the game-side service loop to exit.  0xff is
+ * never a valid guess: game.h caps GUESS_RANGE at 255 for exactly this
+ * reason.
+ */
+#define IPC_SHUTDOWN	0xff
+
+/*
+ * One single-producer/single-consumer byte ring.  Cursors live on
+ * their own cache lines; the producer owns tail, the consumer owns
+ * head, and each side futex-waits on the other's cursor only when the
+ * ring is empty (or full), so the common non-empty round trip costs no
+ * syscall at all.
+ */
+struct ipc_ring {
+	_Atomic uint32_t tail __attribute__((aligned(64)));	/* producer */
+	_Atomic uint32_t head __attribute__((aligned(64)));	/* consumer */
+	uint8_t buf[IPC_RING_SZ] __attribute__((aligned(64)));
+};
+
+struct ipc_shm {
+	uint32_t magic;
+	struct ipc_ring guess;	/* harness -> game */
+	struct ipc_ring result;	/* game -> harness */
+};
+
+/*
+ * Map the POSIX shm transport @name, creating and initializing it when
+ * @create is set (the game side creates, the harness attaches).
+ */
+struct ipc_shm *ipc_shm_map(const char *name, int create);
+void ipc_shm_unmap(struct ipc_shm *shm, const char *name, int created);
+
+void ipc_ring_push(struct ipc_ring *r, uint8_t v);
+uint8_t ipc_ring_pop(struct ipc_ring *r);
+
+/* Game-side service loop behind --ipc shm:NAME. */
+int ipc_serve(const char *name);
+
+#endif /* IPC_H */
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * guess_dev.c - "guess a number" as a misc character device
+ *
+ * Exposes the game at /dev/guess for syscall-overhead experiments:
+ * GUESS_IOC_BATCH submits an array of guesses and gets back per-round
+ * results plus aggregate counters, so userspace pays one syscall per
+ * batch instead of a write+read pair per round.  Guesses stream
+ * through a page-sized bounce buffer, so arbitrarily large batches
+ * need no large kernel allocation.
+ */
+
+#include <linux/fs.h>
+#include <linux/miscdevice.h>
+#include <linux/module.h>
+#include <linux/random.h>
+#include <linux/sched/signal.h>
+#include <linux/slab.h>
+#include <linux/uaccess.h>
+
+#include "guess_ioctl.h"
+
+#define GUESS_CHUNK	PAGE_SIZE
+#define GUESS_RANGE	10
+
+static long guess_play_batch(struct guess_batch __user *uarg)
+{
+	struct guess_batch batch;
+	u8 *buf;
+	u64 done = 0, wins = 0;
+	long ret = 0;
+
+	if (copy_from_user(&batch, uarg, sizeof(batch)))
+		return -EFAULT;
+
+	buf = kmalloc(GUESS_CHUNK, GFP_KERNEL);
+	if (!buf)
+		return -ENOMEM;
+
+	while (done < batch.count) {
+		u64 n = min_t(u64, batch.count - done, GUESS_CHUNK);
+		u64 i;
+
+		/* count is user-controlled; stay killable mid-batch */
+		if (fatal_signal_pending(current)) {
+			ret = -EINTR;
+			break;
+		}
+
+		if (copy_from_user(buf, u64_to_user_ptr(batch.guesses + done),
+				   n)) {
+			ret = -EFAULT;
+			break;
+		}
+
+		for (i = 0; i < n; i++) {
+			u8 won = buf[i] == get_random_u32() % GUESS_RANGE;
+
+			wins += won;
+			buf[i] = won;
+		}
+
+		if (batch.results &&
+		    copy_to_user(u64_to_user_ptr(batch.results + done), buf,
+				 n)) {
+			ret = -EFAULT;
+			break;
+		}
+		done += n;
+		cond_resched();
+	}
+
+	kfree(buf);
+	if (ret)
+		return ret;
+
+	batch.wins = wins;
+	batch.losses = batch.count - wins;
+	if (copy_to_user(uarg, &batch, sizeof(batch)))
+		return -EFAULT;
+	return 0;
+}
+
+static long guess_ioctl(struct file *file, unsigned int cmd,
+			unsigned long arg)
+{
+	switch (cmd) {
+	case GUESS_IOC_BATCH:
+		return guess_play_batch((struct guess_batch __user *)arg);
+	default:
+		return -ENOTTY;
+	}
+}
+
+static const struct file_operations guess_fops = {
+	.owner		= THIS_MODULE,
+	.unlocked_ioctl	= guess_ioctl,
+};
+
+static struct miscdevice guess_dev = {
+	.minor	= MISC_DYNAMIC_MINOR,
+	.name	= "guess",
+	.fops	= &guess_fops,
+	.mode	= 0666,
+};
+
+module_misc_device(guess_dev);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("guess-a-number batched game device");
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: GPL-2.0 WITH Linux-syscall-note */
+/*
+ * guess_ioctl.h - userspace interface of the /dev/guess device
+ *
+ * Shared between the module and userspace tools; keep it uapi-clean
+ * (fixed-width types, pointers carried as __u64).
+ */
+#ifndef GUESS_IOCTL_H
+#define GUESS_IOCTL_H
+
+#include <linux/ioctl.h>
+#include <linux/types.h>
+
+/*
+ * One ioctl plays @count rounds: @guesses points at count digit bytes
+ * (0-9), @results (optional, 0 to skip) receives one byte per round
+ * (1 = win), and @wins/@losses come back filled with the aggregate.
+ */
+struct guess_batch {
+	__u64 count;
+	__u64 guesses;		/* const __u8 __user * */
+	__u64 results;		/* __u8 __user *, may be 0 */
+	__u64 wins;		/* out */
+	__u64 losses;		/* out */
+};
+
+#define GUESS_IOC_MAGIC		'g'
+#define GUESS_IOC_BATCH		_IOWR(GUESS_IOC_MAGIC, 1, struct guess_batch)
+
+#endif /* GUESS_IOCTL_H */
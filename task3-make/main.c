@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * main.c - entry point for the "guess a number" game (task3 split)
+ *
+ * All game logic lives in the library (game.c); this file only parses
+ * the command line and dispatches.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "dist.h"
+#include "game.h"
+#include "hugebuf.h"
+#include "input.h"
+#include "ipc.h"
+#include "output.h"
+#include "replay.h"
+#include "selfprof.h"
+#include "stats.h"
+#include "server.h"
+#include "sim.h"
+#include "tournament.h"
+
+/*
+ * Run @rounds rounds in-process.  Guesses come from the bulk input
+ * layer (mmap for regular files, large block reads otherwise); once
+ * input is exhausted the remaining rounds fall back to random
+ * self-play.  @verbose emits the per-round win/lose lines through the
+ * batched output layer for text-parsing consumers; the default stays
+ * aggregate-only.
+ */
+static int run_batch(long rounds, int verbose, int want_stats)
+{
+	static struct stats_table table;
+	struct guess_output out;
+	struct guess_input in;
+	long wins = 0, losses = 0, round = 0;
+	int eof = 0;
+
+	if (guess_input_init(&in, STDIN_FILENO) < 0 ||
+	    (verbose && guess_output_init(&out, STDOUT_FILENO) < 0)) {
+		fprintf(stderr, "guess: cannot set up batch I/O\n");
+		return 1;
+	}
+
+	while (round < rounds) {
+		int guess, won;
+
+		if (!eof) {
+			guess = guess_input_next(&in);
+			if (guess < 0) {
+				eof = 1;
+				continue;
+			}
+		} else {
+			guess = game_random();
+		}
+
+		if (want_stats) {
+			int gen = game_random();
+
+			stats_add(&table, guess, gen);
+			won = guess == gen;
+		} else {
+			won = game_check_guess(guess);
+		}
+		if (won)
+			wins++;
+		else
+			losses++;
+		if (verbose)
+			guess_output_result(&out, won);
+		round++;
+	}
+
+	guess_input_destroy(&in);
+	if (verbose)
+		guess_output_destroy(&out);
+	printf("rounds=%ld wins=%ld losses=%ld\n", rounds, wins, losses);
+	if (want_stats)
+		stats_dump(&table, stdout);
+	return 0;
+}
+
+/*
+ * Self-play @rounds rounds in blocks, journaling one (seed, rounds)
+ * entry per block so the run can be regenerated with --replay.
+ */
+static int run_recorded(long rounds, uint64_t seed, const char *path)
+{
+	struct replay_journal j;
+	long wins = 0, left = rounds;
+	uint64_t base, idx = 0;
+
+	if (replay_journal_open(&j, path) < 0) {
+		perror(path);
+		return 1;
+	}
+
+	/* Unseeded runs journal entropy-derived block seeds. */
+	base = seed ? seed : game_random64();
+
+	while (left > 0) {
+		long n = left < (1L << 20) ? left : (1L << 20);
+		uint64_t bseed = base + idx++ * 0x9e3779b97f4a7c15ULL;
+
+		if (replay_journal_append(&j, bseed, n) < 0) {
+			perror(path);
+			replay_journal_close(&j);
+			return 1;
+		}
+		wins += replay_play_block(bseed, n);
+		left -= n;
+	}
+
+	if (replay_journal_close(&j) < 0) {
+		perror(path);
+		return 1;
+	}
+	printf("rounds=%ld wins=%ld losses=%ld\n", rounds, wins,
+	       rounds - wins);
+	return 0;
+}
+
+static void usage(const char *argv0)
+{
+	fprintf(stderr,
+		"usage: %s [--seed S] [--batch N] [--tournament N [--threads T]] [--simulate P [--rounds R]] [--serve PORT]\n"
+		"       [--record FILE --batch N] [--replay FILE] [--ipc shm:NAME] [--verbose|--quiet] [--stats] [--numa] [--hugepages]\n"
+		"       [--tournament N --send HOST:PORT] [--aggregate PORT --nodes N]\n",
+		argv0);
+}
+
+int main(int argc, char *argv[])
+{
+	struct selfprof sp = { .active = 0 };
+	long batch = 0, tournament = 0, simulate = 0, rounds = 100;
+	const char *record = NULL, *replay = NULL, *ipc = NULL;
+	const char *send_to = NULL;
+	int verbose = 0, want_stats = 0, numa = 0;
+	uint64_t seed = 0;
+	int nthreads = 0, port = 0, agg_port = 0, nnodes = 1;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 0);
+			game_seed(seed);
+		} else if (!strcmp(argv[i], "--tournament") && i + 1 < argc) {
+			tournament = strtol(argv[++i], NULL, 10);
+			if (tournament <= 0) {
+				fprintf(stderr,
+					"guess: bad tournament size '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			nthreads = (int)strtol(argv[++i], NULL, 10);
+		} else if (!strcmp(argv[i], "--simulate") && i + 1 < argc) {
+			simulate = strtol(argv[++i], NULL, 10);
+			if (simulate <= 0) {
+				fprintf(stderr,
+					"guess: bad player count '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--rounds") && i + 1 < argc) {
+			rounds = strtol(argv[++i], NULL, 10);
+			if (rounds <= 0) {
+				fprintf(stderr, "guess: bad round count '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--numa")) {
+			numa = 1;
+		} else if (!strcmp(argv[i], "--hugepages")) {
+			hugebuf_enable(1);
+		} else if (!strcmp(argv[i], "--stats")) {
+			want_stats = 1;
+		} else if (!strcmp(argv[i], "--verbose")) {
+			verbose = 1;
+		} else if (!strcmp(argv[i], "--quiet")) {
+			verbose = 0;
+		} else if (!strcmp(argv[i], "--record") && i + 1 < argc) {
+			record = argv[++i];
+		} else if (!strcmp(argv[i], "--replay") && i + 1 < argc) {
+			replay = argv[++i];
+		} else if (!strcmp(argv[i], "--ipc") && i + 1 < argc) {
+			ipc = argv[++i];
+			if (strncmp(ipc, "shm:", 4) || ipc[4] == '\0') {
+				fprintf(stderr,
+					"guess: bad transport '%s' (want shm:NAME)\n",
+					ipc);
+				return 2;
+			}
+			ipc += 4;
+		} else if (!strcmp(argv[i], "--send") && i + 1 < argc) {
+			send_to = argv[++i];
+		} else if (!strcmp(argv[i], "--aggregate") && i + 1 < argc) {
+			agg_port = (int)strtol(argv[++i], NULL, 10);
+			if (agg_port <= 0 || agg_port > 65535) {
+				fprintf(stderr, "guess: bad port '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--nodes") && i + 1 < argc) {
+			nnodes = (int)strtol(argv[++i], NULL, 10);
+			if (nnodes <= 0) {
+				fprintf(stderr, "guess: bad node count '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--serve") && i + 1 < argc) {
+			port = (int)strtol(argv[++i], NULL, 10);
+			if (port <= 0 || port > 65535) {
+				fprintf(stderr, "guess: bad port '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else if (!strcmp(argv[i], "--batch") && i + 1 < argc) {
+			batch = strtol(argv[++i], NULL, 10);
+			if (batch <= 0) {
+				fprintf(stderr, "guess: bad batch size '%s'\n",
+					argv[i]);
+				return 2;
+			}
+		} else {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	if (port)
+		return guess_server_run(port) ? 1 : 0;
+
+	if (ipc)
+		return ipc_serve(ipc) ? 1 : 0;
+
+	if (agg_port) {
+		static struct stats_table table;
+
+		if (dist_aggregate_run(agg_port, nnodes,
+				       want_stats ? &table : NULL))
+			return 1;
+		if (want_stats)
+			stats_dump(&table, stdout);
+		return 0;
+	}
+
+	if (send_to) {
+		if (!tournament) {
+			fprintf(stderr,
+				"guess: --send needs --tournament N\n");
+			return 2;
+		}
+		return dist_worker_run(send_to, tournament, nthreads,
+				       seed) ? 1 : 0;
+	}
+
+	if (getenv("GUESS_SELFPROF") && selfprof_start(&sp))
+		fprintf(stderr, "guess: perf counters unavailable\n");
+
+	if (replay) {
+		struct tournament_result res;
+
+		if (replay_run(replay, &res)) {
+			fprintf(stderr, "guess: cannot replay '%s'\n", replay);
+			return 1;
+		}
+		printf("rounds=%ld wins=%ld losses=%ld\n",
+		       res.rounds, res.wins, res.losses);
+		selfprof_report(&sp, res.rounds);
+		return 0;
+	}
+
+	if (record) {
+		if (!batch) {
+			fprintf(stderr,
+				"guess: --record needs --batch N (self-play)\n");
+			return 2;
+		}
+		return run_recorded(batch, seed, record);
+	}
+
+	if (simulate) {
+		struct tournament_result res;
+
+		if (guess_simulate(simulate, rounds, nthreads, seed, &res)) {
+			fprintf(stderr, "guess: simulation failed\n");
+			return 1;
+		}
+		printf("players=%ld rounds=%ld wins=%ld losses=%ld\n",
+		       simulate, res.rounds, res.wins, res.losses);
+		selfprof_report(&sp, res.rounds);
+		return 0;
+	}
+
+	if (tournament) {
+		static struct stats_table table;
+		struct tournament_result res;
+
+		if (tournament_run(tournament, nthreads, seed, &res,
+				   want_stats ? &table : NULL, numa)) {
+			fprintf(stderr, "guess: tournament failed\n");
+			return 1;
+		}
+		printf("rounds=%ld wins=%ld losses=%ld\n",
+		       res.rounds, res.wins, res.losses);
+		if (want_stats)
+			stats_dump(&table, stdout);
+		selfprof_report(&sp, res.rounds);
+		return 0;
+	}
+
+	if (batch) {
+		int ret = run_batch(batch, verbose, want_stats);
+
+		selfprof_report(&sp, batch);
+		return ret;
+	}
+
+	return game_play_round();
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * numa.c - NUMA topology discovery and worker pinning
+ *
+ * An unpinned tournament lets the scheduler migrate workers across
+ * sockets mid-run, turning their buffers and RNG state into
+ * remote-memory traffic.  Topology comes straight from
+ * /sys/devices/system/node (no libnuma dependency); workers are
+ * spread round-robin across nodes and pinned to a whole node rather
+ * than a single CPU, so the scheduler can still balance within the
+ * socket.  Everything a worker owns is first-touched after pinning
+ * and therefore node-local.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "numa.h"
+
+/* "0-3,8-11\n" -> cpu_set_t */
+static int parse_cpulist(const char *list, cpu_set_t *set)
+{
+	const char *p = list;
+
+	CPU_ZERO(set);
+	while (*p && *p != '\n') {
+		char *end;
+		long lo, hi;
+
+		lo = strtol(p, &end, 10);
+		if (end == p)
+			return -1;
+		hi = lo;
+		if (*end == '-') {
+			p = end + 1;
+			hi = strtol(p, &end, 10);
+			if (end == p)
+				return -1;
+		}
+		for (; lo <= hi; lo++)
+			if (lo < CPU_SETSIZE)
+				CPU_SET(lo, set);
+		p = end;
+		if (*p == ',')
+			p++;
+	}
+	return 0;
+}
+
+int numa_topology_load(struct numa_topology *topo)
+{
+	int node;
+
+	topo->nnodes = 0;
+	for (node = 0; node < NUMA_MAX_NODES; node++) {
+		char path[64], list[4096];
+		FILE *f;
+
+		snprintf(path, sizeof(path),
+			 "/sys/devices/system/node/node%d/cpulist", node);
+		f = fopen(path, "r");
+		if (!f)
+			break;
+		if (!fgets(list, sizeof(list), f) ||
+		    parse_cpulist(list, &topo->node_cpus[topo->nnodes]) ||
+		    CPU_COUNT(&topo->node_cpus[topo->nnodes]) == 0) {
+			fclose(f);
+			continue;
+		}
+		fclose(f);
+		topo->nnodes++;
+	}
+
+	if (topo->nnodes == 0) {
+		/* no sysfs topology: one node, all CPUs */
+		long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+		long cpu;
+
+		CPU_ZERO(&topo->node_cpus[0]);
+		for (cpu = 0; cpu < ncpu && cpu < CPU_SETSIZE; cpu++)
+			CPU_SET(cpu, &topo->node_cpus[0]);
+		topo->nnodes = 1;
+	}
+	return 0;
+}
+
+int numa_pin_worker(const struct numa_topology *topo, int worker_idx)
+{
+	int node = worker_idx % topo->nnodes;
+
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+			       &topo->node_cpus[node]);
+	return node;
+}
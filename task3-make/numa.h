@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * numa.h - NUMA topology discovery and worker pinning
+ */
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <sched.h>
+
+#define NUMA_MAX_NODES	64
+
+struct numa_topology {
+	int nnodes;
+	cpu_set_t node_cpus[NUMA_MAX_NODES];
+};
+
+/*
+ * Read node->cpu maps from sysfs; machines without NUMA information
+ * come back as one node spanning all CPUs, so callers need no special
+ * case.
+ */
+int numa_topology_load(struct numa_topology *topo);
+
+/*
+ * Pin the calling thread to the CPUs of the node chosen round-robin
+ * for @worker_idx; returns the node id.  Memory the worker touches
+ * first after pinning (TLS RNG state, on-stack round buffers) is
+ * allocated node-local by first-touch.
+ */
+int numa_pin_worker(const struct numa_topology *topo, int worker_idx);
+
+#endif /* NUMA_H */
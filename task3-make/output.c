@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * output.c - batched win/lose output layer
+ *
+ * With stdout on a pipe at libc defaults, every per-round result line
+ * costs a write(2).  Non-TTY output instead accumulates into a 4 MB
+ * buffer flushed with writev -- the pending message rides in a second
+ * iovec, so even a flush triggered mid-append stays a single syscall.
+ * A real TTY keeps per-line writes so interactive play feels live.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "output.h"
+
+#define OUT_BUF_SZ	(4u << 20)
+
+static const char msg_win[] = "You win\n";
+static const char msg_lose[] = "You loose\n";
+
+int guess_output_init(struct guess_output *out, int fd)
+{
+	out->fd = fd;
+	out->pos = 0;
+	out->tty = isatty(fd);
+	out->buf = NULL;
+
+	if (!out->tty) {
+		out->buf = malloc(OUT_BUF_SZ);
+		if (!out->buf)
+			return -1;
+	}
+	return 0;
+}
+
+static int out_writev(int fd, struct iovec *iov, int cnt)
+{
+	while (cnt) {
+		ssize_t n = writev(fd, iov, cnt);
+
+		if (n < 0)
+			return -1;
+		while (cnt && (size_t)n >= iov->iov_len) {
+			n -= iov->iov_len;
+			iov++;
+			cnt--;
+		}
+		if (cnt) {
+			iov->iov_base = (char *)iov->iov_base + n;
+			iov->iov_len -= n;
+		}
+	}
+	return 0;
+}
+
+static int out_flush_with(struct guess_output *out, const char *tail,
+			  size_t tail_len)
+{
+	struct iovec iov[2];
+	int cnt = 0;
+
+	if (out->pos) {
+		iov[cnt].iov_base = out->buf;
+		iov[cnt].iov_len = out->pos;
+		cnt++;
+	}
+	if (tail_len) {
+		iov[cnt].iov_base = (char *)tail;
+		iov[cnt].iov_len = tail_len;
+		cnt++;
+	}
+	out->pos = 0;
+	return cnt ? out_writev(out->fd, iov, cnt) : 0;
+}
+
+void guess_output_result(struct guess_output *out, int won)
+{
+	const char *msg = won ? msg_win : msg_lose;
+	size_t len = won ? sizeof(msg_win) - 1 : sizeof(msg_lose) - 1;
+
+	if (out->tty) {
+		out_flush_with(out, msg, len);
+		return;
+	}
+
+	if (out->pos + len > OUT_BUF_SZ) {
+		out_flush_with(out, msg, len);
+		return;
+	}
+	memcpy(out->buf + out->pos, msg, len);
+	out->pos += len;
+}
+
+int guess_output_flush(struct guess_output *out)
+{
+	return out_flush_with(out, NULL, 0);
+}
+
+void guess_output_destroy(struct guess_output *out)
+{
+	guess_output_flush(out);
+	free(out->buf);
+	out->buf = NULL;
+}
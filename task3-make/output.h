@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * output.h - batched win/lose output layer
+ */
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+
+struct guess_output {
+	int fd;
+	int tty;
+	size_t pos;
+	char *buf;
+};
+
+/*
+ * Attach to @fd.  On a TTY every result is written immediately; on a
+ * pipe or file results accumulate into a multi-megabyte buffer and
+ * leave in batched vector writes.
+ */
+int guess_output_init(struct guess_output *out, int fd);
+
+/* Append one "You win"/"You loose" line. */
+void guess_output_result(struct guess_output *out, int won);
+
+int guess_output_flush(struct guess_output *out);
+void guess_output_destroy(struct guess_output *out);
+
+#endif /* OUTPUT_H */
@@ -0,0 +1,29 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * probes.h - USDT tracepoints for the game hot path
+ *
+ * Compiled in with SDT=1 (adds -DHAVE_SDT); a probe site is then a
+ * single nop until a tracer attaches.  Without HAVE_SDT the macros
+ * expand to nothing, so default builds carry no trace overhead at
+ * all.  Provider name: guess.
+ */
+#ifndef PROBES_H
+#define PROBES_H
+
+#ifdef HAVE_SDT
+
+#include <sys/sdt.h>
+
+#define GUESS_PROBE(name)		DTRACE_PROBE(guess, name)
+#define GUESS_PROBE1(name, a)		DTRACE_PROBE1(guess, name, a)
+#define GUESS_PROBE2(name, a, b)	DTRACE_PROBE2(guess, name, a, b)
+
+#else
+
+#define GUESS_PROBE(name)		do { } while (0)
+#define GUESS_PROBE1(name, a)		do { } while (0)
+#define GUESS_PROBE2(name, a, b)	do { } while (0)
+
+#endif /* HAVE_SDT */
+
+#endif /* PROBES_H */
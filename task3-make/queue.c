@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * queue.c - bounded lock-free MPMC ring
+ *
+ * Vyukov-style ring: every cell carries a sequence number that encodes
+ * whether it is free for the producer or full for the consumer of a
+ * given lap, so push and pop each need one CAS on their own cursor and
+ * no lock.  Head and tail live on separate cache lines to keep
+ * producers and consumers from bouncing the same line; a mutex here
+ * would serialize exactly the part the tournament parallelizes.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "queue.h"
+
+int mpmc_queue_init(struct mpmc_queue *q, size_t capacity)
+{
+	size_t i;
+
+	if (capacity < 2 || (capacity & (capacity - 1)))
+		return -1;
+
+	q->cells = calloc(capacity, sizeof(*q->cells));
+	if (!q->cells)
+		return -1;
+
+	for (i = 0; i < capacity; i++)
+		atomic_init(&q->cells[i].seq, i);
+	atomic_init(&q->head, 0);
+	atomic_init(&q->tail, 0);
+	q->mask = capacity - 1;
+	return 0;
+}
+
+void mpmc_queue_destroy(struct mpmc_queue *q)
+{
+	free(q->cells);
+	q->cells = NULL;
+}
+
+int mpmc_queue_push(struct mpmc_queue *q, void *item)
+{
+	size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+	for (;;) {
+		struct mpmc_cell *cell = &q->cells[pos & q->mask];
+		size_t seq = atomic_load_explicit(&cell->seq,
+						  memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&q->head,
+					&pos, pos + 1,
+					memory_order_relaxed,
+					memory_order_relaxed)) {
+				cell->data = item;
+				atomic_store_explicit(&cell->seq, pos + 1,
+						      memory_order_release);
+				return 0;
+			}
+			/* pos reloaded by the failed CAS */
+		} else if (diff < 0) {
+			return -1;	/* full */
+		} else {
+			pos = atomic_load_explicit(&q->head,
+						   memory_order_relaxed);
+		}
+	}
+}
+
+int mpmc_queue_pop(struct mpmc_queue *q, void **item)
+{
+	size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	for (;;) {
+		struct mpmc_cell *cell = &q->cells[pos & q->mask];
+		size_t seq = atomic_load_explicit(&cell->seq,
+						  memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&q->tail,
+					&pos, pos + 1,
+					memory_order_relaxed,
+					memory_order_relaxed)) {
+				*item = cell->data;
+				atomic_store_explicit(&cell->seq,
+						      pos + q->mask + 1,
+						      memory_order_release);
+				return 0;
+			}
+		} else if (diff < 0) {
+			return -1;	/* empty */
+		} else {
+			pos = atomic_load_explicit(&q->tail,
+						   memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * queue.h - bounded lock-free MPMC ring
+ */
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+struct mpmc_cell {
+	atomic_size_t seq;
+	void *data;
+};
+
+struct mpmc_queue {
+	/* enqueue and dequeue cursors on separate cache lines */
+	atomic_size_t head __attribute__((aligned(64)));
+	atomic_size_t tail __attribute__((aligned(64)));
+	struct mpmc_cell *cells __attribute__((aligned(64)));
+	size_t mask;
+};
+
+/* @capacity must be a power of two.  Returns 0 or -1 on ENOMEM. */
+int mpmc_queue_init(struct mpmc_queue *q, size_t capacity);
+void mpmc_queue_destroy(struct mpmc_queue *q);
+
+/* Non-blocking; return 0 on success, -1 when full/empty. */
+int mpmc_queue_push(struct mpmc_queue *q, void *item);
+int mpmc_queue_pop(struct mpmc_queue *q, void **item);
+
+#endif /* QUEUE_H */
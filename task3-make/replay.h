@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * replay.h - deterministic record/replay via seed journal
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+
+#include "tournament.h"
+
+/*
+ * Journal format: a flat array of entries, one per played block.
+ * A (seed, rounds) pair fully determines a self-play block, so 16
+ * bytes reproduce any number of rounds.
+ */
+struct replay_entry {
+	uint64_t seed;
+	uint64_t rounds;
+};
+
+struct replay_journal {
+	int fd;
+	int used;
+	struct replay_entry buf[512];
+};
+
+int replay_journal_open(struct replay_journal *j, const char *path);
+int replay_journal_append(struct replay_journal *j, uint64_t seed,
+			  uint64_t rounds);
+int replay_journal_close(struct replay_journal *j);
+
+/* Play one self-play block from @seed; returns the win count. */
+long replay_play_block(uint64_t seed, uint64_t rounds);
+
+/*
+ * Regenerate every round recorded in @path and return the aggregate
+ * counts.  Pure PRNG regeneration: no I/O or interaction per round.
+ */
+int replay_run(const char *path, struct tournament_result *res);
+
+#endif /* REPLAY_H */
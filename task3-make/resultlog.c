@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * resultlog.c - append-only binary per-round result log
+ *
+ * The old way to capture outcomes was parsing "You win"/"You loose"
+ * text through a pipe: a write, a read and string matching per round.
+ * Here the log file is grown in 16 MB extents, each mmap'd once;
+ * appending a round is two stores and a pointer bump, and retired
+ * extents are msync'd and dropped so a long run never accumulates
+ * dirty pages.  Readers mmap the same flat record array directly.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "resultlog.h"
+
+#define EXTENT_SZ	(16u << 20)
+
+static uint64_t now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static int log_map_extent(struct result_log *log, size_t off)
+{
+	if (ftruncate(log->fd, off + EXTENT_SZ) < 0)
+		return -1;
+	log->map = mmap(NULL, EXTENT_SZ, PROT_READ | PROT_WRITE, MAP_SHARED,
+			log->fd, off);
+	if (log->map == MAP_FAILED) {
+		log->map = NULL;
+		return -1;
+	}
+	madvise(log->map, EXTENT_SZ, MADV_SEQUENTIAL);
+	log->ext_off = off;
+	log->pos = 0;
+	return 0;
+}
+
+int result_log_open(struct result_log *log, const char *path)
+{
+	log->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (log->fd < 0)
+		return -1;
+	log->last_us = now_us();
+	if (log_map_extent(log, 0)) {
+		close(log->fd);
+		return -1;
+	}
+	return 0;
+}
+
+int result_log_append(struct result_log *log, uint64_t seed, uint8_t guess,
+		      uint8_t result)
+{
+	struct result_record *rec;
+	uint64_t now;
+
+	if (log->pos + sizeof(*rec) > EXTENT_SZ) {
+		msync(log->map, EXTENT_SZ, MS_ASYNC);
+		munmap(log->map, EXTENT_SZ);
+		if (log_map_extent(log, log->ext_off + EXTENT_SZ))
+			return -1;
+	}
+
+	rec = (struct result_record *)(log->map + log->pos);
+	rec->seed = seed;
+	/* delta from the previous record: summing reconstructs absolute
+	 * time, so long runs don't alias the way since-open deltas do */
+	now = now_us();
+	rec->ts_delta = (uint32_t)(now - log->last_us);
+	log->last_us = now;
+	rec->guess = guess;
+	rec->result = result;
+	rec->pad = 0;
+	log->pos += sizeof(*rec);
+	return 0;
+}
+
+int result_log_close(struct result_log *log)
+{
+	int ret = 0;
+
+	if (log->map) {
+		msync(log->map, EXTENT_SZ, MS_ASYNC);
+		munmap(log->map, EXTENT_SZ);
+	}
+	/* drop the unwritten tail of the last extent */
+	if (ftruncate(log->fd, log->ext_off + log->pos) < 0)
+		ret = -1;
+	if (close(log->fd) < 0)
+		ret = -1;
+	log->fd = -1;
+	log->map = NULL;
+	return ret;
+}
+
+int result_log_map(const char *path, const struct result_record **recs,
+		   size_t *count)
+{
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) < 0 || st.st_size % sizeof(**recs)) {
+		close(fd);
+		return -1;
+	}
+	if (st.st_size == 0) {
+		close(fd);
+		*recs = NULL;
+		*count = 0;
+		return 0;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return -1;
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+	*recs = map;
+	*count = st.st_size / sizeof(**recs);
+	return 0;
+}
+
+void result_log_unmap(const struct result_record *recs, size_t count)
+{
+	if (recs)
+		munmap((void *)recs, count * sizeof(*recs));
+}
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * resultlog.h - append-only binary per-round result log
+ */
+#ifndef RESULTLOG_H
+#define RESULTLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Fixed 16-byte record; the file is a flat array of these, readable
+ * in place by mmap.  ts_delta is microseconds since the previous
+ * record (since open for the first); absolute time is the running sum,
+ * so overnight runs stay unambiguous.  The field wraps only if two
+ * consecutive rounds are more than ~71.6 minutes apart, a gap no
+ * workload of this logger has.  guess 0xff marks rounds whose guess
+ * the logger never saw (interactive play inside the library).
+ */
+struct result_record {
+	uint64_t seed;		/* session base seed, 0 when auto-seeded */
+	uint32_t ts_delta;
+	uint8_t guess;
+	uint8_t result;		/* 1 = win */
+	uint16_t pad;
+};
+
+#define RESULT_GUESS_UNKNOWN	0xff
+
+struct result_log {
+	int fd;
+	char *map;		/* current extent */
+	size_t ext_off;		/* file offset of the extent */
+	size_t pos;		/* append offset within the extent */
+	uint64_t last_us;	/* timestamp of the previous record */
+};
+
+int result_log_open(struct result_log *log, const char *path);
+int result_log_append(struct result_log *log, uint64_t seed, uint8_t guess,
+		      uint8_t result);
+int result_log_close(struct result_log *log);
+
+/* Map an existing log read-only for offline analysis. */
+int result_log_map(const char *path, const struct result_record **recs,
+		   size_t *count);
+void result_log_unmap(const struct result_record *recs, size_t count);
+
+#endif /* RESULTLOG_H */
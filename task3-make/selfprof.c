@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * selfprof.c - opt-in perf_event self-profiler
+ *
+ * Answers "where did that slow tournament go" without attaching perf
+ * externally: a fixed set of hardware and software counters (cycles
+ * through dTLB misses and page faults) opened with inherit=1 so worker
+ * threads are included, read once at the end and reported per million
+ * rounds.  Costs nothing unless started; events the host cannot count
+ * are skipped one by one, and it degrades to silence on kernels or
+ * containers where perf_event_open is denied entirely.
+ */
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "selfprof.h"
+
+#define DTLB_READ_MISS	(PERF_COUNT_HW_CACHE_DTLB |		\
+			 (PERF_COUNT_HW_CACHE_OP_READ << 8) |	\
+			 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+	unsigned int type;
+	unsigned long long config;
+	const char *name;
+} selfprof_events[SELFPROF_NEVENTS] = {
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,	   "cycles" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,  "instructions" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,  "cache-misses" },
+	{ PERF_TYPE_HW_CACHE, DTLB_READ_MISS,		   "dTLB-load-misses" },
+	{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS,   "page-faults" },
+};
+
+static int perf_open(unsigned int type, unsigned long long config)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.inherit = 1;	/* follow tournament/scheduler threads */
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int selfprof_start(struct selfprof *sp)
+{
+	int i, opened = 0;
+
+	sp->active = 0;
+	for (i = 0; i < SELFPROF_NEVENTS; i++) {
+		sp->fds[i] = perf_open(selfprof_events[i].type,
+				       selfprof_events[i].config);
+		if (sp->fds[i] >= 0)
+			opened++;
+	}
+	if (!opened)
+		return -1;
+
+	for (i = 0; i < SELFPROF_NEVENTS; i++) {
+		if (sp->fds[i] < 0)
+			continue;
+		ioctl(sp->fds[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(sp->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+	sp->active = 1;
+	return 0;
+}
+
+void selfprof_report(struct selfprof *sp, long rounds)
+{
+	double scale = rounds > 0 ? 1e6 / (double)rounds : 0.0;
+	int i;
+
+	if (!sp->active)
+		return;
+
+	fprintf(stderr, "selfprof (per 1M rounds, %ld rounds total):\n",
+		rounds);
+	for (i = 0; i < SELFPROF_NEVENTS; i++) {
+		long long val = 0;
+
+		if (sp->fds[i] < 0)
+			continue;
+		ioctl(sp->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+		if (read(sp->fds[i], &val, sizeof(val)) != sizeof(val))
+			val = -1;
+		fprintf(stderr, "  %-16s %.0f\n", selfprof_events[i].name,
+			(double)val * scale);
+		close(sp->fds[i]);
+	}
+	sp->active = 0;
+}
@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * selfprof.h - opt-in perf_event self-profiler
+ */
+#ifndef SELFPROF_H
+#define SELFPROF_H
+
+#define SELFPROF_NEVENTS	6
+
+struct selfprof {
+	int fds[SELFPROF_NEVENTS];
+	int active;
+};
+
+/*
+ * Start counting cycles, instructions, branch-misses, cache-misses,
+ * dTLB-load-misses and page-faults for this process and the threads it
+ * spawns.  Events the host cannot count are skipped individually;
+ * returns 0 when at least one opened, -1 when perf_event_open is
+ * unavailable entirely (counters then report nothing).
+ */
+int selfprof_start(struct selfprof *sp);
+
+/* Stop and print per-million-rounds rates to stderr. */
+void selfprof_report(struct selfprof *sp, long rounds);
+
+#endif /* SELFPROF_H */
@@ -0,0 +1,301 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * server.c - epoll-based multiplayer game server
+ *
+ * Replaces the inetd-style process-per-connection wrapper: one
+ * thread, one epoll loop, per-session state in a slab preallocated at
+ * startup and indexed by fd, so tens of thousands of concurrent
+ * sessions cost a few dozen bytes each and no fork.  The protocol is
+ * the game's text form: every digit byte received plays one round and
+ * gets back "You win" or "You loose"; everything else is skipped.
+ *
+ * The loop is deliberately shared-nothing so a SO_REUSEPORT
+ * thread-per-core variant can run one instance per worker later.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "hist.h"
+#include "server.h"
+
+#define MAX_SESSIONS	65536
+#define MAX_EVENTS	256
+#define OUTBUF_SZ	512
+#define RDBUF_SZ	4096
+
+static const char msg_win[] = "You win\n";
+static const char msg_lose[] = "You loose\n";
+
+struct session {
+	int fd;			/* -1 when free */
+	long wins;
+	long losses;
+	/* replies not yet accepted by the socket */
+	short outlen;
+	short outpos;
+	char outbuf[OUTBUF_SZ];
+};
+
+static struct session sessions[MAX_SESSIONS];
+
+/* per-guess service latency; dumped on SIGUSR1 */
+static struct latency_hist guess_hist;
+static volatile sig_atomic_t hist_dump_req;
+
+static void sigusr1_handler(int sig)
+{
+	(void)sig;
+	hist_dump_req = 1;
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int set_nonblock(int fd)
+{
+	int flags = fcntl(fd, F_GETFL, 0);
+
+	return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static void session_close(int epfd, struct session *s)
+{
+	epoll_ctl(epfd, EPOLL_CTL_DEL, s->fd, NULL);
+	close(s->fd);
+	s->fd = -1;
+}
+
+/* Flush pending replies; returns -1 when the connection is dead. */
+static int session_flush(int epfd, struct session *s)
+{
+	while (s->outpos < s->outlen) {
+		ssize_t n = write(s->fd, s->outbuf + s->outpos,
+				  s->outlen - s->outpos);
+
+		if (n > 0) {
+			s->outpos += n;
+			continue;
+		}
+		if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			struct epoll_event ev = {
+				.events = EPOLLIN | EPOLLOUT,
+				.data.fd = s->fd,
+			};
+
+			/* compact so the buffer keeps its full capacity */
+			if (s->outpos) {
+				memmove(s->outbuf, s->outbuf + s->outpos,
+					s->outlen - s->outpos);
+				s->outlen -= s->outpos;
+				s->outpos = 0;
+			}
+			epoll_ctl(epfd, EPOLL_CTL_MOD, s->fd, &ev);
+			return 0;
+		}
+		if (errno == EINTR)
+			continue;
+		return -1;
+	}
+
+	if (s->outlen) {
+		struct epoll_event ev = {
+			.events = EPOLLIN,
+			.data.fd = s->fd,
+		};
+
+		epoll_ctl(epfd, EPOLL_CTL_MOD, s->fd, &ev);
+		s->outlen = 0;
+		s->outpos = 0;
+	}
+	return 0;
+}
+
+/*
+ * Queue one reply, flushing to the socket when the buffer fills so a
+ * prompt reader gets every reply no matter how many guesses one read
+ * batch carried.  Replies are dropped only when the socket itself
+ * refuses the bytes (a genuinely slow reader); returns -1 when the
+ * connection is dead.
+ */
+static int session_reply(int epfd, struct session *s, const char *msg,
+			 int len)
+{
+	if (s->outlen + len > OUTBUF_SZ) {
+		if (session_flush(epfd, s) < 0)
+			return -1;
+		if (s->outlen + len > OUTBUF_SZ)
+			return 0;	/* backpressure: drop */
+	}
+	memcpy(s->outbuf + s->outlen, msg, len);
+	s->outlen += len;
+	return 0;
+}
+
+static int session_input(int epfd, struct session *s)
+{
+	char buf[RDBUF_SZ];
+
+	for (;;) {
+		ssize_t n = read(s->fd, buf, sizeof(buf));
+		ssize_t i;
+
+		if (n == 0)
+			return -1;
+		if (n < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return 0;
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+
+		for (i = 0; i < n; i++) {
+			uint64_t t0;
+			int guess;
+
+#if GUESS_RANGE <= 10
+			if (buf[i] < '0' || buf[i] >= '0' + GUESS_RANGE)
+				continue;
+			guess = buf[i] - '0';
+#else
+			/* wide-range builds take raw byte values */
+			guess = (unsigned char)buf[i];
+			if (guess > GUESS_MAX)
+				continue;
+#endif
+			t0 = now_ns();
+			if (game_check_guess(guess)) {
+				s->wins++;
+				if (session_reply(epfd, s, msg_win,
+						  sizeof(msg_win) - 1) < 0)
+					return -1;
+			} else {
+				s->losses++;
+				if (session_reply(epfd, s, msg_lose,
+						  sizeof(msg_lose) - 1) < 0)
+					return -1;
+			}
+			hist_record(&guess_hist, now_ns() - t0);
+		}
+		if (session_flush(epfd, s) < 0)
+			return -1;
+	}
+}
+
+static void server_accept(int epfd, int listen_fd)
+{
+	for (;;) {
+		struct epoll_event ev = { .events = EPOLLIN };
+		int fd = accept(listen_fd, NULL, NULL);
+
+		if (fd < 0)
+			return;
+		if (fd >= MAX_SESSIONS || set_nonblock(fd) < 0) {
+			close(fd);
+			continue;
+		}
+
+		memset(&sessions[fd], 0, sizeof(sessions[fd]));
+		sessions[fd].fd = fd;
+		ev.data.fd = fd;
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+			close(fd);
+	}
+}
+
+int guess_server_run(int port)
+{
+	struct epoll_event ev, events[MAX_EVENTS];
+	struct sockaddr_in addr;
+	int listen_fd, epfd, one = 1;
+	int i;
+
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGUSR1, sigusr1_handler);
+	for (i = 0; i < MAX_SESSIONS; i++)
+		sessions[i].fd = -1;
+
+	listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (listen_fd < 0) {
+		perror("socket");
+		return -1;
+	}
+	setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+	if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(listen_fd, SOMAXCONN) < 0 ||
+	    set_nonblock(listen_fd) < 0) {
+		perror("listen");
+		close(listen_fd);
+		return -1;
+	}
+
+	epfd = epoll_create1(0);
+	if (epfd < 0) {
+		perror("epoll_create1");
+		close(listen_fd);
+		return -1;
+	}
+	ev.events = EPOLLIN;
+	ev.data.fd = listen_fd;
+	epoll_ctl(epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+	fprintf(stderr, "guess: serving on port %d\n", port);
+
+	for (;;) {
+		int n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+
+		if (hist_dump_req) {
+			hist_dump_req = 0;
+			hist_dump(&guess_hist, stderr, "per-guess latency");
+		}
+
+		for (i = 0; i < n; i++) {
+			int fd = events[i].data.fd;
+			struct session *s;
+
+			if (fd == listen_fd) {
+				server_accept(epfd, listen_fd);
+				continue;
+			}
+
+			s = &sessions[fd];
+			if (s->fd < 0)
+				continue;
+
+			if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+				session_close(epfd, s);
+				continue;
+			}
+			if ((events[i].events & EPOLLOUT) &&
+			    session_flush(epfd, s) < 0) {
+				session_close(epfd, s);
+				continue;
+			}
+			if ((events[i].events & EPOLLIN) &&
+			    session_input(epfd, s) < 0)
+				session_close(epfd, s);
+		}
+	}
+}
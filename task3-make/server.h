@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * server.h - epoll-based multiplayer game server
+ */
+#ifndef SERVER_H
+#define SERVER_H
+
+/*
+ * Serve guess sessions on TCP @port until killed.  Single-threaded
+ * epoll loop; one session per connection, no per-connection process
+ * or thread.  Returns only on setup failure (-1).
+ */
+int guess_server_run(int port);
+
+#endif /* SERVER_H */
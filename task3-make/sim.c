@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * sim.c - concurrent interactive-player simulation
+ *
+ * Load model for the server work: players that think between guesses.
+ * Each simulated player is a coroutine that plays one round and then
+ * yields (its "think" pause, in virtual time), so thousands of
+ * players interleave on each scheduler thread the way real sessions
+ * interleave on the epoll loop.  Players are split across one
+ * scheduler thread per core; counters merge after join, tournament
+ * style.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "coro.h"
+#include "game.h"
+#include "sim.h"
+
+#define CACHELINE	64
+
+struct player {
+	struct coro coro;
+	long rounds;
+	long wins;
+};
+
+struct sim_shard {
+	long players;
+	long rounds_per_player;
+	uint64_t seed;		/* 0 = auto */
+	long wins;
+	long losses;
+	int failed;
+} __attribute__((aligned(CACHELINE)));
+
+static void player_fn(struct coro *coro, void *arg)
+{
+	struct player *p = arg;
+	long r;
+
+	for (r = 0; r < p->rounds; r++) {
+		p->wins += game_check_guess(game_random());
+		/* think pause: let every other ready player run */
+		coro_yield(coro);
+	}
+	(void)coro;
+}
+
+static void *shard_fn(void *arg)
+{
+	struct sim_shard *sh = arg;
+	struct coro_sched sched;
+	struct player **players;
+	struct arena parena;
+	long i, spawned = 0;
+
+	if (sh->seed)
+		game_seed(sh->seed);
+
+	players = calloc(sh->players, sizeof(*players));
+	if (!players || arena_init(&parena, sizeof(struct player),
+				   sh->players)) {
+		free(players);
+		sh->failed = 1;
+		return NULL;
+	}
+	if (coro_sched_init(&sched, sh->players)) {
+		arena_destroy(&parena);
+		free(players);
+		sh->failed = 1;
+		return NULL;
+	}
+
+	for (i = 0; i < sh->players; i++) {
+		struct player *p = arena_alloc(&parena);
+
+		if (!p) {
+			sh->failed = 1;
+			break;
+		}
+		p->wins = 0;
+		p->rounds = sh->rounds_per_player;
+		players[i] = p;
+		if (coro_spawn(&sched, &p->coro, player_fn, p)) {
+			sh->failed = 1;
+			break;
+		}
+		spawned++;
+	}
+
+	coro_sched_run(&sched);
+
+	for (i = 0; i < spawned; i++)
+		sh->wins += players[i]->wins;
+	sh->losses = spawned * sh->rounds_per_player - sh->wins;
+
+	/* bulk teardown: one reset instead of per-player frees */
+	arena_reset(&parena);
+	arena_destroy(&parena);
+	coro_sched_destroy(&sched);
+	free(players);
+	return NULL;
+}
+
+int guess_simulate(long players, long rounds_per_player, int nthreads,
+		   uint64_t seed, struct tournament_result *res)
+{
+	struct sim_shard *shards;
+	pthread_t *tids;
+	long per, extra;
+	int i, started;
+	int ret = 0;
+
+	if (nthreads <= 0)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads < 1)
+		nthreads = 1;
+	if ((long)nthreads > players)
+		nthreads = (int)(players > 0 ? players : 1);
+
+	shards = calloc(nthreads, sizeof(*shards));
+	tids = calloc(nthreads, sizeof(*tids));
+	if (!shards || !tids) {
+		free(shards);
+		free(tids);
+		return -1;
+	}
+
+	per = players / nthreads;
+	extra = players % nthreads;
+	for (i = 0; i < nthreads; i++) {
+		shards[i].players = per + (i < extra);
+		shards[i].rounds_per_player = rounds_per_player;
+		shards[i].seed = seed ?
+			seed + (uint64_t)i * 0x9e3779b97f4a7c15ULL : 0;
+	}
+
+	for (started = 0; started < nthreads; started++)
+		if (pthread_create(&tids[started], NULL, shard_fn,
+				   &shards[started]))
+			break;
+	if (started < nthreads)
+		ret = -1;
+
+	res->rounds = res->wins = res->losses = 0;
+	for (i = 0; i < started; i++) {
+		pthread_join(tids[i], NULL);
+		if (shards[i].failed)
+			ret = -1;
+		res->wins += shards[i].wins;
+		res->losses += shards[i].losses;
+	}
+	res->rounds = res->wins + res->losses;
+
+	free(shards);
+	free(tids);
+	return ret;
+}
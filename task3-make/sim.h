@@ -0,0 +1,21 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * sim.h - concurrent interactive-player simulation
+ */
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#include "tournament.h"
+
+/*
+ * Simulate @players concurrent interactive sessions of
+ * @rounds_per_player rounds each, as coroutines multiplexed over
+ * @nthreads scheduler threads (0 = one per online CPU).  Aggregate
+ * counts land in @res; returns 0 or -1 on setup failure.
+ */
+int guess_simulate(long players, long rounds_per_player, int nthreads,
+		   uint64_t seed, struct tournament_result *res);
+
+#endif /* SIM_H */
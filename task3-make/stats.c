@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * stats.c - streaming guess/generated distribution statistics
+ *
+ * Replaces the awk pass over gigabytes of harness text: the joint
+ * distribution is counted inline while the rounds run, one increment
+ * in a table small enough to stay cache-resident, and only the merge
+ * and the summary below ever run cold.
+ */
+
+#include "stats.h"
+
+void stats_merge(struct stats_table *dst, const struct stats_table *src)
+{
+	int g, n;
+
+	for (g = 0; g < GUESS_RANGE; g++)
+		for (n = 0; n < GUESS_RANGE; n++)
+			dst->counts[g][n] += src->counts[g][n];
+}
+
+void stats_dump(const struct stats_table *t, FILE *f)
+{
+	uint64_t guess_tot[GUESS_RANGE] = { 0 };
+	uint64_t gen_tot[GUESS_RANGE] = { 0 };
+	uint64_t total = 0, wins = 0;
+	int g, n;
+
+	for (g = 0; g < GUESS_RANGE; g++)
+		for (n = 0; n < GUESS_RANGE; n++) {
+			uint64_t c = t->counts[g][n];
+
+			guess_tot[g] += c;
+			gen_tot[n] += c;
+			total += c;
+			if (g == n)
+				wins += c;
+		}
+
+	fprintf(f, "guess x generated (rows guess %d..%d):\n",
+		GUESS_MIN, GUESS_MAX);
+	for (g = 0; g < GUESS_RANGE; g++) {
+		fprintf(f, "  %d:", g + GUESS_MIN);
+		for (n = 0; n < GUESS_RANGE; n++)
+			fprintf(f, " %8llu",
+				(unsigned long long)t->counts[g][n]);
+		fprintf(f, "\n");
+	}
+
+	fprintf(f, "guess marginal:    ");
+	for (g = 0; g < GUESS_RANGE; g++)
+		fprintf(f, " %8llu", (unsigned long long)guess_tot[g]);
+	fprintf(f, "\ngenerated marginal:");
+	for (n = 0; n < GUESS_RANGE; n++)
+		fprintf(f, " %8llu", (unsigned long long)gen_tot[n]);
+	fprintf(f, "\nrounds=%llu wins=%llu losses=%llu\n",
+		(unsigned long long)total, (unsigned long long)wins,
+		(unsigned long long)(total - wins));
+}
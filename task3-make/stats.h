@@ -0,0 +1,34 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * stats.h - streaming guess/generated distribution statistics
+ */
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "game.h"
+
+/*
+ * Full joint distribution of (guess, generated) pairs: a fixed
+ * GUESS_RANGE x GUESS_RANGE table of 64-bit counters (800 bytes for
+ * the 0-9 game, two cache lines' worth per row), updated inline per
+ * round.  Wins are the diagonal, so win/loss splits and both
+ * marginals fall out of the same table.
+ */
+struct stats_table {
+	uint64_t counts[GUESS_RANGE][GUESS_RANGE];
+};
+
+static inline void stats_add(struct stats_table *t, int guess, int gen)
+{
+	t->counts[guess - GUESS_MIN][gen - GUESS_MIN]++;
+}
+
+void stats_merge(struct stats_table *dst, const struct stats_table *src);
+
+/* Compact summary: joint table, marginals, win totals. */
+void stats_dump(const struct stats_table *t, FILE *f);
+
+#endif /* STATS_H */
@@ -0,0 +1,31 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * tournament.h - multi-threaded Monte-Carlo tournament engine
+ */
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <stdint.h>
+
+#include "stats.h"
+
+struct tournament_result {
+	long rounds;
+	long wins;
+	long losses;
+};
+
+/*
+ * Run @rounds self-play rounds sharded across @nthreads threads
+ * (0 means one per online CPU).  A non-zero @seed makes the run
+ * deterministic regardless of thread count.  A non-NULL @stats
+ * switches workers to the pair-recording path and merges the joint
+ * guess/generated distribution into it.  @numa_report pins workers
+ * round-robin across NUMA nodes and prints per-node throughput to
+ * stderr.  Returns 0 on success, -1 on thread-creation failure.
+ */
+int tournament_run(long rounds, int nthreads, uint64_t seed,
+		   struct tournament_result *res,
+		   struct stats_table *stats, int numa_report);
+
+#endif /* TOURNAMENT_H */